@@ -0,0 +1,250 @@
+/*---------------------------------------------------------------------------*\
+|   Host model of the double-buffered block handoff                           |
+|                                                                             |
+|   Runs the protocol of i2s_handler (main.xc) and audio_effects              |
+|   (process_audio.xc) on two threads: the I2S side fills in[] and plays      |
+|   out[] of the block it owns frame by frame, hands it over after N frames   |
+|   and takes the other one back; the DSP side copies in[] to out[] and runs  |
+|   cppdsp_process_block() on the block it was handed. The streaming          |
+|   channel is one queue per direction.                                       |
+|                                                                             |
+|   For N = 1, 8, 16, 32 and 64 it checks that every access is made by the    |
+|   owner of the block and that the output equals the chain run offline in    |
+|   blocks of N, delayed by 2 N frames. It reports the latency, the DSP time  |
+|   per block against the block period at 48 kHz (the slack left for          |
+|   jitter) and the throughput of the whole loop. A block processed before    |
+|   cppdsp_init_eq() must pass unchanged. Exit code 1 on an error.            |
+|                                                                             |
+|   Build (from this directory): make blocksim, or                            |
+|       g++ -O3 -std=c++11 -pthread -DDSP_BLOCK_FRAMES=64 -I../src            |
+|           -o blocksim blocksim.cpp ../src/eq32.cpp ../src/eq32_tables.cpp   |
+|           ../src/limiter32.cpp ../src/fixmath.cpp ../src/cppdsp.cpp         |
+|           ../src/dsp_preset.cpp ../src/dynamics32.cpp ../src/dsp_load.c     |
+|   DSP_BLOCK_FRAMES must be at least the largest N, so that the chain        |
+|   graph does not split the blocks.                                          |
+|                                                                             |
+|   Usage:                                                                    |
+|       blocksim [seconds]                                                    |
+\*---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "cppdsp.h"
+#include "dsp_load.h"
+
+#define SIM_STOP 2u                             // not a block index
+
+static const size_t blockSizes[] = { 1, 8, 16, 32, 64 };
+
+enum { I2S_SIDE, DSP_SIDE };
+
+// one direction of the streaming channel
+class Queue
+{
+public:
+    void put(unsigned v)
+    {
+        std::lock_guard<std::mutex> lock(m);
+        q.push_back(v);
+        cv.notify_one();
+    }
+
+    unsigned get(void)
+    {
+        std::unique_lock<std::mutex> lock(m);
+        cv.wait(lock, [this] { return !q.empty(); });
+        unsigned v = q.front();
+        q.pop_front();
+        return v;
+    }
+
+private:
+    std::mutex m;
+    std::condition_variable cv;
+    std::deque<unsigned> q;
+};
+
+struct Handoff
+{
+    size_t frames;                              // N
+    std::vector<int32_t> in[2], out[2];
+    std::atomic<int> owner[2];
+    std::atomic<int> violations;
+    Queue toDsp, toI2s;
+    dsp_load_stats_t dspStats;
+
+    explicit Handoff(size_t n) : frames(n), violations(0)
+    {
+        for (int b = 0; b < 2; b++)
+        {
+            in[b].assign(n * NUM_CHANS, 0);
+            out[b].assign(n * NUM_CHANS, 0);
+        }
+        // the I2S side starts with block 0
+        owner[0] = I2S_SIDE;
+        owner[1] = DSP_SIDE;
+    }
+
+    void check(unsigned b, int side)
+    {
+        if (owner[b] != side)
+            violations++;
+    }
+
+    // gives block b to the other side
+    void release(unsigned b, int side)
+    {
+        check(b, side);
+        owner[b] = 1 - side;
+    }
+};
+
+// audio_effects()
+static void dspSide(Handoff &h)
+{
+    unsigned owned = 1;
+
+    dsp_load_reset(&h.dspStats, 0);
+    for (;;)
+    {
+        unsigned filled = h.toDsp.get();
+        if (filled == SIM_STOP)
+            break;
+
+        h.release(owned, DSP_SIDE);
+        h.toI2s.put(owned);
+        owned = filled;
+
+        uint32_t start = dsp_load_host_ticks();
+        h.check(owned, DSP_SIDE);
+        memcpy(&h.out[owned][0], &h.in[owned][0], h.frames * NUM_CHANS * sizeof(int32_t));
+        cppdsp_process_block(&h.out[owned][0], h.frames);
+        dsp_load_update(&h.dspStats, dsp_load_host_ticks() - start);
+    }
+}
+
+// i2s_handler(): per frame send (play out[]) and receive (fill in[])
+static void i2sSide(Handoff &h, const std::vector<int32_t> &input,
+                    std::vector<int32_t> &output, size_t total)
+{
+    unsigned cur = 0;
+    size_t frame = 0;
+
+    for (size_t n = 0; n < total; n++)
+    {
+        h.check(cur, I2S_SIDE);
+        memcpy(&output[n * NUM_CHANS], &h.out[cur][frame * NUM_CHANS],
+               NUM_CHANS * sizeof(int32_t));
+        memcpy(&h.in[cur][frame * NUM_CHANS], &input[n * NUM_CHANS],
+               NUM_CHANS * sizeof(int32_t));
+
+        if (++frame == h.frames)
+        {
+            h.release(cur, I2S_SIDE);
+            h.toDsp.put(cur);
+            cur = h.toI2s.get();
+            frame = 0;
+        }
+    }
+    h.toDsp.put(SIM_STOP);
+}
+
+static void generate(std::vector<int32_t> &sig, size_t frames)
+{
+    unsigned seed = 1;
+    double lp = 0;
+
+    sig.resize(frames * NUM_CHANS);
+    for (size_t n = 0; n < frames; n++)
+        for (int c = 0; c < NUM_CHANS; c++)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            lp = 0.9 * lp + 0.1 * ((int32_t) seed / 2147483648.0);
+            sig[n * NUM_CHANS + c] = (int32_t) (lp * 0x7FFFFFFF);
+        }
+}
+
+int main(int argc, char *argv[])
+{
+    double seconds = argc > 1 ? atof(argv[1]) : 2.0;
+    size_t total = (size_t) (seconds * SAMPLE_FREQUENCY);
+    std::vector<int32_t> input;
+    int errors = 0;
+
+    // whole blocks of the largest N
+    total = (total + 63) / 64 * 64;
+    if (total == 0)
+        total = 64;
+    generate(input, total);
+
+    printf("%lu frames of %d channels at %d Hz\n", (unsigned long) total, NUM_CHANS,
+           SAMPLE_FREQUENCY);
+    // before cppdsp_init_eq() the chain passes the audio unchanged
+    {
+        std::vector<int32_t> block(input.begin(), input.begin() + 64 * NUM_CHANS);
+
+        cppdsp_process_block(&block[0], 64);
+        bool same = std::equal(block.begin(), block.end(), input.begin());
+        printf("block before cppdsp_init_eq(): %s\n", same ? "passed unchanged" : "CHANGED");
+        errors += !same;
+    }
+
+    printf("   N  latency          DSP block (mean/max)     period    slack   throughput"
+           "  check\n");
+
+    for (size_t i = 0; i < sizeof(blockSizes) / sizeof(blockSizes[0]); i++)
+    {
+        size_t N = blockSizes[i];
+        std::vector<int32_t> reference(input), output(total * NUM_CHANS);
+        Handoff h(N);
+
+        if (N > DSP_BLOCK_FRAMES)
+        {
+            fprintf(stderr, "blocksim: build with -DDSP_BLOCK_FRAMES=%lu or more\n",
+                    (unsigned long) N);
+            return 1;
+        }
+
+        cppdsp_init_eq();
+        for (size_t n = 0; n < total; n += N)
+            cppdsp_process_block(&reference[n * NUM_CHANS], N);
+
+        cppdsp_init_eq();
+        uint32_t start = dsp_load_host_ticks();
+        std::thread dsp(dspSide, std::ref(h));
+        i2sSide(h, input, output, total);
+        dsp.join();
+        double wall = (dsp_load_host_ticks() - start) * 1e-9;
+
+        // output[n + 2N] = reference[n], the first 2N frames are silent
+        size_t delay = 2 * N * NUM_CHANS;
+        bool same = true;
+        for (size_t k = 0; k < output.size(); k++)
+            if (output[k] != (k < delay ? 0 : reference[k - delay]))
+                same = false;
+
+        double period = 1e9 * N / SAMPLE_FREQUENCY;
+        double mean = dsp_load_mean(&h.dspStats);
+        bool ok = same && h.violations == 0;
+
+        printf("%4lu  %4lu frames %5.2f ms  %8.0f / %8u ns  %8.0f ns  %5.1f%%  %7.1f x rt"
+               "  %s\n", (unsigned long) N, (unsigned long) (2 * N),
+               2e3 * N / SAMPLE_FREQUENCY, mean, h.dspStats.max_ticks, period,
+               100. * (1. - mean / period), total / wall / SAMPLE_FREQUENCY,
+               ok ? "ok" : same ? "OWNERSHIP" : "OUTPUT MISMATCH");
+        if (h.violations)
+            printf("      %d accesses to a block owned by the other side\n",
+                   (int) h.violations);
+        errors += !ok;
+    }
+
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,164 @@
+/*---------------------------------------------------------------------------*\
+|   Host benchmark of the partitioned FFT convolver against the direct FIR    |
+|                                                                             |
+|   Convolves stereo pink noise with a synthetic room impulse response        |
+|   (decaying noise) of 1k, 8k and 48k taps, once with FIR32 in direct form   |
+|   and once with FFTConvolverNode for partition sizes from 64 to 4096. It    |
+|   prints the time per sample, the speed as a multiple of realtime at        |
+|   48 kHz stereo and, for the convolver, the added latency and the largest   |
+|   deviation from the FIR32 output (dBFS) on the same quantized taps.        |
+|                                                                             |
+|   The signal is full scale, damped by 24 dB as in cppdsp_process_block(),   |
+|   and processed in blocks of 16 frames. The direct FIR only runs on the     |
+|   first 0.25 s, which is also the stretch that is compared.                 |
+|                                                                             |
+|   Build (from this directory):                                              |
+|       g++ -O3 -std=c++11 -I../src -o convbench convbench.cpp                |
+|           fft_convolver.cpp ../src/dsp_load.c                               |
+|                                                                             |
+|   Usage:                                                                    |
+|       convbench [seconds]                                                   |
+\*---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+#include "fir32.h"
+#include "fft_convolver.h"
+#include "dsp_load.h"
+
+#define BENCH_FS        48000
+#define BENCH_CHANS     2
+#define BENCH_BLOCK     16
+#define MAX_TAPS        48000
+
+typedef std::vector<int32_t> Signal;
+
+static const int tapCounts[] = { 1024, 8192, 48000 };
+static const int partitions[] = { 64, 256, 1024, 4096 };
+
+// pink noise (Paul Kellet's filter), full scale - 24 dB
+static void generate(Signal &sig, size_t frames)
+{
+    double b0 = 0, b1 = 0, b2 = 0, b3 = 0, b4 = 0, b5 = 0, b6 = 0;
+    unsigned seed = 1;
+
+    sig.resize(frames * BENCH_CHANS);
+
+    for (size_t n = 0; n < frames; n++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        double w = ((seed >> 8) & 0xFFFF) / 32768.0 - 1.0;
+
+        b0 = 0.99886 * b0 + w * 0.0555179;
+        b1 = 0.99332 * b1 + w * 0.0750759;
+        b2 = 0.96900 * b2 + w * 0.1538520;
+        b3 = 0.86650 * b3 + w * 0.3104856;
+        b4 = 0.55000 * b4 + w * 0.5329522;
+        b5 = -0.7616 * b5 - w * 0.0168980;
+        double x = (b0 + b1 + b2 + b3 + b4 + b5 + b6 + w * 0.5362) * 0.11;
+        b6 = w * 0.115926;
+
+        x = x > 1 ? 1 : x < -1 ? -1 : x;
+        for (int c = 0; c < BENCH_CHANS; c++)
+            sig[n * BENCH_CHANS + c] = (int32_t) (x * 2147483647.0) >> 4;
+    }
+}
+
+// noise decaying by 60 dB over the length, peak 0.5, quantized to Q8.24
+static void roomResponse(std::vector<int32_t> &h, int taps)
+{
+    unsigned seed = 7;
+
+    h.resize(taps);
+    for (int k = 0; k < taps; k++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        double w = ((seed >> 8) & 0xFFFF) / 32768.0 - 1.0;
+        double x = k == 0 ? 1.0 : w * pow(10., -3. * k / taps);
+        h[k] = (int32_t) (0.5 * x * fixed_one);
+    }
+}
+
+static double nsPerFrame(const dsp_load_stats_t &stats, size_t frames)
+{
+    return (double) stats.sum_ticks / frames;
+}
+
+static void benchTaps(int taps, const Signal &in, size_t frames, size_t refFrames)
+{
+    static FIR32<MAX_TAPS, BENCH_CHANS> fir;
+    std::vector<int32_t> h;
+    dsp_load_stats_t stats;
+
+    roomResponse(h, taps);
+
+    // direct form reference
+    Signal ref(in.begin(), in.begin() + refFrames * BENCH_CHANS);
+
+    fir.setCoefficients(&h[0], taps);
+    dsp_load_reset(&stats, 0);
+    for (size_t n = 0; n < refFrames; n += BENCH_BLOCK)
+    {
+        uint32_t start = dsp_load_host_ticks();
+        fir.processBlock(&ref[n * BENCH_CHANS], BENCH_BLOCK);
+        dsp_load_update(&stats, dsp_load_host_ticks() - start);
+    }
+
+    double ns = nsPerFrame(stats, refFrames) / BENCH_CHANS;
+    printf("%5d taps  direct        %9.2f ns/sample  %7.2f x realtime\n",
+           taps, ns, 1e9 / (BENCH_FS * BENCH_CHANS) / ns);
+
+    std::vector<float> hf(taps);
+    for (int k = 0; k < taps; k++)
+        hf[k] = (float) h[k] / fixed_one;
+
+    for (size_t p = 0; p < sizeof(partitions) / sizeof(partitions[0]); p++)
+    {
+        int B = partitions[p];
+        FFTConvolverNode conv(BENCH_CHANS, B, &hf[0], taps, 1);
+        Signal out(in);
+        double maxErr = 0;
+
+        dsp_load_reset(&stats, 0);
+        for (size_t n = 0; n < frames; n += BENCH_BLOCK)
+        {
+            int32_t *const blockIn[1] = { &out[n * BENCH_CHANS] };
+            uint32_t start = dsp_load_host_ticks();
+            conv.processBlock(blockIn, &out[n * BENCH_CHANS], BENCH_BLOCK);
+            dsp_load_update(&stats, dsp_load_host_ticks() - start);
+        }
+
+        // the convolver lags by one partition
+        for (size_t i = 0; i + B * BENCH_CHANS < ref.size(); i++)
+        {
+            double e = fabs((double) out[i + B * BENCH_CHANS] - ref[i]);
+            if (e > maxErr)
+                maxErr = e;
+        }
+
+        ns = nsPerFrame(stats, frames) / BENCH_CHANS;
+        printf("%5d taps  fft B=%-4d    %9.2f ns/sample  %7.2f x realtime  "
+               "latency %6.2f ms  err %6.1f dBFS\n",
+               taps, B, ns, 1e9 / (BENCH_FS * BENCH_CHANS) / ns,
+               1e3 * B / BENCH_FS, maxErr > 0 ? 20 * log10(maxErr / 2147483648.0) : -999.);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    double seconds = argc > 1 ? atof(argv[1]) : 2.0;
+    size_t frames = (size_t) (seconds * BENCH_FS) / BENCH_BLOCK * BENCH_BLOCK;
+    size_t refFrames = BENCH_FS / 4 / BENCH_BLOCK * BENCH_BLOCK;
+    Signal sig;
+
+    if (frames < refFrames)
+        frames = refFrames;
+    generate(sig, frames);
+
+    for (size_t t = 0; t < sizeof(tapCounts) / sizeof(tapCounts[0]); t++)
+        benchTaps(tapCounts[t], sig, frames, refFrames);
+
+    return 0;
+}
@@ -0,0 +1,1599 @@
+/*---------------------------------------------------------------------------*\
+|   Host benchmark and regression check for the fixed-point DSP kernels       |
+|                                                                             |
+|   Each bench feeds impulse, log sweep, pink noise and a full-scale square   |
+|   wave, damped by 24 dB as in cppdsp_process_block(), through one module    |
+|   and prints ns/frame and a CRC32 of the output:                            |
+|       eq         every EQ32 filter type, max error against double precision |
+|       block      EQ32 blocks (interleaved, planar, error feedback) and      |
+|                  LimiterNode against process() per frame                    |
+|       template   EQ32N and BiquadCascade against the macro built EQ32       |
+|       noise      low-frequency EQs with and without error feedback: RMS     |
+|                  and max deviation from double precision, ns/frame          |
+|       limiter    Limiter32, frames and dB it lets into its final clamp      |
+|       window     Limiter32 lookahead of 1 to 10 ms at 48 and 96 kHz         |
+|       divide     limiter gain: integer divide against the reciprocal table, |
+|                  all divisors, worst-case time per gain (once)              |
+|       dynamics   Dynamics32 compressor, gate and one-frame blocks           |
+|       multiband  3 band MultibandDynamics, null test with idle bands        |
+|       fir        FIR32 from 16 to 512 taps against a naive sum              |
+|       chain      cppdsp chain hand-written and as a DspGraph                |
+|       nodes      DelayNode at 0 and the maximum delay, MixerNode sum of a   |
+|                  graph with scratch blocks, mixer saturation                |
+|       crossover  4-way LR2/LR4/LR8 crossover at 48 and 96 kHz               |
+|       flat       8 bands, 4 flat, classified kernels against the full one,  |
+|                  also with one band switched flat and back, and the         |
+|                  bypass against the 0 dB design it replaces                 |
+|       ramp       BiquadCascade coefficient ramps: click energy, cost and    |
+|                  stability of every intermediate set, an EQ32N ramp set     |
+|                  right after construction (once)                            |
+|       design     designEQ() against designEQInt() and the design tables,    |
+|                  table positions from integer parameters (once)             |
+|       memory     static data size of the chain objects (once)               |
+|                                                                             |
+|   -check runs every bench on 1 s per signal and compares each CRC with the  |
+|   golden file, -golden writes that file. Both exit non-zero on a mismatch   |
+|   or a failed test, see "make check".                                       |
+|                                                                             |
+|   Build (from this directory): make dspbench, or                            |
+|       g++ -O3 -std=c++11 -I../src -o dspbench dspbench.cpp                  |
+|           ../src/eq32.cpp ../src/eq32_tables.cpp ../src/limiter32.cpp       |
+|           ../src/fixmath.cpp ../src/dynamics32.cpp ../src/dsp_load.c        |
+|                                                                             |
+|   Usage:                                                                    |
+|       dspbench [seconds] [bench ...]                                        |
+|       dspbench -check dspbench.crc | -golden dspbench.crc                   |
+\*---------------------------------------------------------------------------*/
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <map>
+#include <new>
+#include <string>
+#include <vector>
+#include "eq32.h"
+#include "eq32_tables.h"
+#include "fir32.h"
+#include "limiter32.h"
+#include "dynamics32.h"
+#include "multiband_dynamics.h"
+#include "biquad_cascade.h"
+#include "dsp_graph.h"
+#include "dsp_nodes.h"
+#include "dsp_load.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define BENCH_FS        48000
+#define BENCH_CHANS     2
+#define BENCH_BLOCK     16
+#define HEADROOM_BITS   4
+#define CHECK_SECONDS   1
+
+enum { IMPULSE, SWEEP, PINK, SQUARE, NUM_SIGNALS };
+
+static const char *signalNames[NUM_SIGNALS] = { "impulse", "sweep", "pink", "square" };
+
+static const char *typeNames[] = {
+    "GAIN", "LOW_PASS", "HIGH_PASS", "BAND_PASS", "NOTCH", "PEAKING",
+    "LOW_SHELF", "HIGH_SHELF", "LOW_SHELFQ", "HIGH_SHELFQ", "ALLPASS"
+};
+
+typedef std::vector<int32_t> Signal;
+
+static void generate(int kind, Signal &sig, size_t frames)
+{
+    const double fullScale = 2147483647.0;
+    double b0 = 0, b1 = 0, b2 = 0, b3 = 0, b4 = 0, b5 = 0, b6 = 0;
+    unsigned seed = 1;
+
+    sig.resize(frames * BENCH_CHANS);
+
+    for (size_t n = 0; n < frames; n++)
+    {
+        double x = 0;
+
+        switch (kind)
+        {
+        case IMPULSE:
+            x = (n % BENCH_FS) == 0 ? 1.0 : 0.0;
+            break;
+
+        case SWEEP:
+        {
+            // 20 Hz .. 20 kHz logarithmic, restarting every second
+            double t = (double)(n % BENCH_FS) / BENCH_FS;
+            double k = log(1000.);
+            x = sin(2 * M_PI * 20. * (exp(k * t) - 1) / k);
+            break;
+        }
+
+        case PINK:
+        {
+            // Paul Kellet's refined pink noise filter
+            seed = seed * 1664525u + 1013904223u;
+            double w = (int32_t) seed / fullScale;
+            b0 = 0.99886 * b0 + w * 0.0555179;
+            b1 = 0.99332 * b1 + w * 0.0750759;
+            b2 = 0.96900 * b2 + w * 0.1538520;
+            b3 = 0.86650 * b3 + w * 0.3104856;
+            b4 = 0.55000 * b4 + w * 0.5329522;
+            b5 = -0.7616 * b5 - w * 0.0168980;
+            x = (b0 + b1 + b2 + b3 + b4 + b5 + b6 + w * 0.5362) * 0.11;
+            b6 = w * 0.115926;
+            break;
+        }
+
+        case SQUARE:
+            x = (n / 48) % 2 ? 1.0 : -1.0;      // 500 Hz
+            break;
+        }
+
+        double v = x * fullScale;
+        if (v > fullScale)
+            v = fullScale;
+        if (v < -fullScale)
+            v = -fullScale;
+
+        for (int c = 0; c < BENCH_CHANS; c++)
+            sig[n * BENCH_CHANS + c] = (int32_t) v >> HEADROOM_BITS;
+    }
+}
+
+static uint32_t crc32(const int32_t *data, size_t words)
+{
+    uint32_t crc = 0xFFFFFFFF;
+    const uint8_t *p = (const uint8_t *) data;
+
+    for (size_t i = 0; i < words * sizeof(int32_t); i++)
+    {
+        crc ^= p[i];
+        for (int k = 0; k < 8; k++)
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+    }
+    return ~crc;
+}
+
+// CRCs of this run by row and signal, compared by -check
+static std::map<std::string, uint32_t> results;
+static int failedTests = 0;
+
+// CRC32 of out, recorded as "row/signal" (spaces as '_')
+static uint32_t fingerprint(const char *row, int kind, const Signal &out)
+{
+    std::string key = std::string(row) + "/" + signalNames[kind];
+    uint32_t crc = crc32(&out[0], out.size());
+
+    for (size_t i = 0; i < key.size(); i++)
+        if (key[i] == ' ')
+            key[i] = '_';
+    results[key] = crc;
+    return crc;
+}
+
+// counts failed pass/fail tests for the exit code
+static bool expect(bool ok)
+{
+    failedTests += !ok;
+    return ok;
+}
+
+// host ticks (ns) of one call of f
+template <typename F>
+static uint32_t timeCall(F f)
+{
+    uint32_t start = dsp_load_host_ticks();
+    f();
+    return dsp_load_host_ticks() - start;
+}
+
+// calls block(n) for n = 0, BENCH_BLOCK, ... < frames and returns the
+// time of these calls in ns/frame
+template <typename F>
+static double timeBlocks(size_t frames, F block)
+{
+    dsp_load_stats_t stats;
+
+    dsp_load_reset(&stats, 0);
+    for (size_t n = 0; n < frames; n += BENCH_BLOCK)
+        dsp_load_update(&stats, timeCall([&] { block(n); }));
+    return (double) stats.sum_ticks / frames;
+}
+
+// prints "row signal ns/frame crc" for out and records and returns the
+// CRC, fmt continues the line
+static uint32_t report(const char *row, int kind, double ns, const Signal &out,
+                   const char *fmt = "", ...)
+{
+    uint32_t crc = fingerprint(row, kind, out);
+    va_list args;
+
+    printf("%-12s %-8s %8.2f ns/frame  crc %08x", row, signalNames[kind], ns, crc);
+    va_start(args, fmt);
+    vprintf(fmt, args);
+    va_end(args);
+    printf("\n");
+    return crc;
+}
+
+static void benchEQ(int type, int kind, const Signal &in, size_t frames)
+{
+    EQ32N<BENCH_CHANS> eq(type, 1000., BENCH_FS, 6., 0.7071);
+    Signal out(in);
+    double c[BIQUAD_COEFFS], x1 = 0, x2 = 0, y1 = 0, y2 = 0, maxErr = 0;
+
+    double ns = timeBlocks(frames, [&](size_t n) {
+        eq.processBlock(&out[n * BENCH_CHANS], BENCH_BLOCK);
+    });
+
+    // double-precision reference on channel 0
+    eq.getCoefficients(c);
+    for (size_t n = 0; n < frames; n++)
+    {
+        double x = in[n * BENCH_CHANS];
+        double y = c[0] * x + c[1] * x1 + c[2] * x2 + c[3] * y1 + c[4] * y2;
+        x2 = x1; x1 = x;
+        y2 = y1; y1 = y;
+        double err = fabs(y - out[n * BENCH_CHANS]);
+        if (err > maxErr)
+            maxErr = err;
+    }
+
+    report(typeNames[type], kind, ns, out, "  max err %10.1f LSB", maxErr);
+}
+
+// processBlock() and processBlockPlanar() against process() per frame,
+// all three must give the same output
+static const struct {
+    int type;
+    double gain;
+} blockCases[] = {
+    { PEAKING_EQ,   6. },                   // full biquad
+    { HIGH_PASS_EQ, 0. },
+    { GAIN_EQ,      6. },                   // gain kernel
+    { PEAKING_EQ,   0. }                    // bypass
+};
+
+template <bool ErrorFeedback>
+static void benchBlockEQ(int c, int kind, const Signal &in, size_t frames)
+{
+    typedef EQ32N<BENCH_CHANS, ErrorFeedback> EQ;
+    EQ perFrame(blockCases[c].type, 1000., BENCH_FS, blockCases[c].gain, 0.7071);
+    EQ interleaved(perFrame), planar(perFrame);
+    Signal outFrame(in), outBlock(in), outPlanar(in.size());
+    std::vector<int32_t> planes[BENCH_CHANS];
+    char name[24];
+
+    for (int ch = 0; ch < BENCH_CHANS; ch++)
+    {
+        planes[ch].resize(frames);
+        for (size_t n = 0; n < frames; n++)
+            planes[ch][n] = in[n * BENCH_CHANS + ch];
+    }
+
+    double nsFrame = timeBlocks(frames, [&](size_t n) {
+        for (size_t k = n; k < n + BENCH_BLOCK; k++)
+            perFrame.process(&outFrame[k * BENCH_CHANS]);
+    });
+    double nsBlock = timeBlocks(frames, [&](size_t n) {
+        interleaved.processBlock(&outBlock[n * BENCH_CHANS], BENCH_BLOCK);
+    });
+    double nsPlanar = timeBlocks(frames, [&](size_t n) {
+        int32_t *ptrs[BENCH_CHANS];
+        for (int ch = 0; ch < BENCH_CHANS; ch++)
+            ptrs[ch] = &planes[ch][n];
+        planar.processBlockPlanar(ptrs, BENCH_BLOCK);
+    });
+
+    for (int ch = 0; ch < BENCH_CHANS; ch++)
+        for (size_t n = 0; n < frames; n++)
+            outPlanar[n * BENCH_CHANS + ch] = planes[ch][n];
+
+    snprintf(name, sizeof(name), "BLOCK%s %s%s", ErrorFeedback ? " EF" : "",
+             typeNames[blockCases[c].type], blockCases[c].gain == 0 &&
+             blockCases[c].type == PEAKING_EQ ? " 0dB" : "");
+    bool same = expect(outBlock == outFrame && outPlanar == outFrame);
+    printf("%-20s %-8s frame %6.2f  block %6.2f  planar %6.2f ns/frame  crc %08x  %s\n",
+           name, signalNames[kind], nsFrame, nsBlock, nsPlanar, fingerprint(name, kind, outFrame),
+           same ? "identical" : "MISMATCH");
+}
+
+static void benchBlock(int kind, const Signal &in, size_t frames)
+{
+    for (size_t c = 0; c < sizeof(blockCases) / sizeof(blockCases[0]); c++)
+    {
+        benchBlockEQ<false>((int) c, kind, in, frames);
+        benchBlockEQ<true>((int) c, kind, in, frames);
+    }
+
+    // LimiterNode block against Limiter32N::process() per frame
+    Limiter32N<BENCH_CHANS, BENCH_FS/1000> lim(-30.2, 0.001, 0.1, 1.0, BENCH_FS);
+    LimiterNode<BENCH_CHANS, BENCH_FS/1000> node(-30.2, 0.001, 0.1, 1.0, BENCH_FS);
+    Signal outFrame(in), outBlock(in);
+
+    double nsFrame = timeBlocks(frames, [&](size_t n) {
+        for (size_t k = n; k < n + BENCH_BLOCK; k++)
+            lim.process(&outFrame[k * BENCH_CHANS]);
+    });
+    double nsBlock = timeBlocks(frames, [&](size_t n) {
+        int32_t *const blockIn[1] = { &outBlock[n * BENCH_CHANS] };
+        node.processBlock(blockIn, blockIn[0], BENCH_BLOCK);
+    });
+
+    bool same = expect(outBlock == outFrame);
+    printf("%-20s %-8s frame %6.2f  block %6.2f ns/frame  crc %08x  %s\n", "BLOCK LIMITER",
+           signalNames[kind], nsFrame, nsBlock, fingerprint("BLOCK LIMITER", kind, outFrame),
+           same ? "identical" : "MISMATCH");
+}
+
+// EQ32::process() of the build before EQ32N: channel count and error
+// feedback set by macros (EQ_CHANS, ERROR_FEEDBACK), kept here verbatim
+// as the reference for the template instantiations
+struct MacroEQ32
+{
+    int32_t coefficients[BIQUAD_COEFFS];
+    int32_t states[BENCH_CHANS][BIQUAD_STATES];
+
+    inline void process(int32_t samples[])
+    {
+        int64_t temp64;
+
+        for (int i=0; i<BENCH_CHANS; i++)
+        {
+            temp64 =  (int64_t) coefficients[0] * samples[i];
+            temp64 += (int64_t) coefficients[1] * states[i][0];
+            temp64 += (int64_t) coefficients[2] * states[i][1];
+            temp64 += (int64_t) coefficients[3] * states[i][2];
+            temp64 += (int64_t) coefficients[4] * states[i][3];
+#if (ERROR_FEEDBACK)
+            temp64 += states[i][4];
+#endif
+            states[i][1] = states[i][0];
+            states[i][0] = samples[i];
+            samples[i] = (int32_t) (temp64 >> fractional_bits);
+            states[i][3] = states[i][2];
+            states[i][2] = samples[i];
+#if (ERROR_FEEDBACK)
+            states[i][4] = (int32_t) (temp64 & error_mask);
+#endif
+        }
+    }
+};
+
+// 5 peaking stages per frame, macro build against EQ32N and BiquadCascade
+static void benchTemplate(int kind, const Signal &in, size_t frames)
+{
+    static const char *names[] = { "MACRO EQ32", "TEMPLATE EQ32N", "TEMPLATE CASCADE" };
+    BiquadParams params[5];
+    MacroEQ32 macro[5];
+    EQ32N<BENCH_CHANS> eq[5];
+    uint32_t crcMacro = 0;
+
+    for (int s = 0; s < 5; s++)
+    {
+        BiquadParams p = { PEAKING_EQ, 100. * (s + 1) * (s + 1), 6. - 3. * s, 1.0 };
+        params[s] = p;
+        eq[s] = EQ32N<BENCH_CHANS>(p.type, p.f0, BENCH_FS, p.gain, p.Q);
+        eq[s].getNewCoefficients(macro[s].coefficients);
+        memset(macro[s].states, 0, sizeof(macro[s].states));
+    }
+    BiquadCascade<5, BENCH_CHANS> cascade(params, BENCH_FS);
+
+    for (int m = 0; m < 3; m++)
+    {
+        Signal out(in);
+
+        double ns = timeBlocks(frames, [&](size_t n) {
+            if (m == 2)
+                cascade.processBlock(&out[n * BENCH_CHANS], BENCH_BLOCK);
+            else
+                for (size_t k = n; k < n + BENCH_BLOCK; k++)
+                    for (int s = 0; s < 5; s++)
+                        if (m == 0)
+                            macro[s].process(&out[k * BENCH_CHANS]);
+                        else
+                            eq[s].process(&out[k * BENCH_CHANS]);
+        });
+
+        uint32_t crc = fingerprint(names[m], kind, out);
+        if (m == 0)
+            crcMacro = crc;
+        printf("%-16s %-8s %8.2f ns/frame  crc %08x  %s\n", names[m], signalNames[kind], ns, crc,
+               m == 0 ? "reference" : expect(crc == crcMacro) ? "identical" : "MISMATCH");
+    }
+}
+
+// quantisation noise of low-frequency stages, where the poles sit close
+// to z = 1, with and without error feedback: RMS and largest deviation
+// from a double-precision biquad with the same (quantized) coefficients
+static const BiquadParams noiseParams[] = {
+    {HIGH_PASS_EQ,  20.0,  0.0, 0.71},
+    {PEAKING_EQ,    40.0,  6.0, 2.0 },
+    {LOW_SHELF_EQ,  100.0, 6.0, 0.71}
+};
+
+template <bool ErrorFeedback>
+static void noiseFloor(const BiquadParams &p, const Signal &in, size_t frames,
+                       double &rms, double &maxErr, double &ns)
+{
+    EQ32N<BENCH_CHANS, ErrorFeedback> eq(p.type, p.f0, BENCH_FS, p.gain, p.Q);
+    Signal out(in);
+    double c[BIQUAD_COEFFS], x1 = 0, x2 = 0, y1 = 0, y2 = 0, sum = 0;
+
+    ns = timeBlocks(frames, [&](size_t n) {
+        eq.processBlock(&out[n * BENCH_CHANS], BENCH_BLOCK);
+    });
+
+    eq.getCoefficients(c);
+    maxErr = 0;
+    for (size_t n = 0; n < frames; n++)
+    {
+        double x = in[n * BENCH_CHANS];
+        double y = c[0] * x + c[1] * x1 + c[2] * x2 + c[3] * y1 + c[4] * y2;
+        double err = y - out[n * BENCH_CHANS];
+        x2 = x1; x1 = x;
+        y2 = y1; y1 = y;
+        sum += err * err;
+        if (fabs(err) > maxErr)
+            maxErr = fabs(err);
+    }
+    rms = 20 * log10(sqrt(sum / frames) / 2147483648.0 + 1e-30);
+}
+
+static void benchNoise(int kind, const Signal &in, size_t frames)
+{
+    for (size_t i = 0; i < sizeof(noiseParams) / sizeof(noiseParams[0]); i++)
+    {
+        const BiquadParams &p = noiseParams[i];
+        double rms0, max0, ns0, rms1, max1, ns1;
+        char name[24];
+
+        noiseFloor<false>(p, in, frames, rms0, max0, ns0);
+        noiseFloor<true>(p, in, frames, rms1, max1, ns1);
+
+        snprintf(name, sizeof(name), "NOISE %s %.0f", typeNames[p.type], p.f0);
+        printf("%-20s %-8s plain %7.1f dBFS %7.0f LSB %5.2f ns  "
+               "feedback %7.1f dBFS %7.0f LSB %5.2f ns\n", name, signalNames[kind],
+               rms0, max0, ns0, rms1, max1, ns1);
+    }
+}
+
+// Limiter32 gain computer over every divisor it can see (the block peak
+// above the threshold, >> 16): integer divide against the reciprocal
+// table of LIMITER_DIVISION_FREE, largest difference in quotient LSB
+// (2^15), relative error against the exact quotient and the time per
+// gain with a signal that is always over the threshold
+class GainComputerProbe : public Limiter32Base
+{
+public:
+    GainComputerProbe(double threshold)
+        : Limiter32Base(threshold, 0.001, 0.1, 1.0, BENCH_FS) {}
+
+    int32_t threshold(void) const { return thresholdLin; }
+    int32_t divide(int32_t d) const { return (thresholdLin / d) << 15; }
+    int32_t table(int32_t d) { return divideThreshold(d); }
+};
+
+// keeps the timed loops from being optimised away
+static volatile uint32_t divideSink;
+
+static void benchDivide(void)
+{
+    static const double thresholds[] = { -0.5, -6., -20., -30.2, -60. };
+    const int reps = 20;
+
+    for (int t = 0; t < 5; t++)
+    {
+        GainComputerProbe probe(thresholds[t]);
+        int32_t first = (probe.threshold() >> 16) + 1;
+        double maxLsb = 0, maxRel = 0;
+        uint32_t sum = 0;
+
+        for (int32_t d = first; d <= 0x7FFF; d++)
+        {
+            double exact = (double) probe.threshold() / d * 32768.;
+            double lsb = fabs((double) probe.table(d) - probe.divide(d)) / 32768.;
+            double rel = fabs(probe.table(d) - exact) / exact;
+            if (lsb > maxLsb)
+                maxLsb = lsb;
+            if (rel > maxRel)
+                maxRel = rel;
+        }
+
+        uint32_t ticksDiv = timeCall([&] {
+            for (int r = 0; r < reps; r++)
+                for (int32_t d = first; d <= 0x7FFF; d++)
+                    sum += probe.divide(d);
+        });
+        uint32_t ticksTab = timeCall([&] {
+            for (int r = 0; r < reps; r++)
+                for (int32_t d = first; d <= 0x7FFF; d++)
+                    sum += probe.table(d);
+        });
+
+        double calls = (double) reps * (0x8000 - first);
+        divideSink = sum;
+        printf("%-12s %6.1f dB  divide %5.2f ns  table %5.2f ns  max %5.3f LSB  "
+               "rel %.1e  %s\n", "DIVIDE", thresholds[t], ticksDiv / calls,
+               ticksTab / calls, maxLsb, maxRel,
+               expect(maxLsb < 1.) ? "below 1 LSB" : "FAILED");
+    }
+}
+
+static void benchLimiter(int kind, const Signal &in, size_t frames)
+{
+    // same settings as the cppdsp chain
+    Limiter32N<BENCH_CHANS, BENCH_FS/1000> lim(-30.2, 0.001, 0.1, 1.0, BENCH_FS);
+    Signal out(in);
+
+    double ns = timeBlocks(frames, [&](size_t n) {
+        for (size_t k = n; k < n + BENCH_BLOCK; k++)
+            lim.process(&out[k * BENCH_CHANS]);
+    });
+
+    // how far the gain leaves the delayed input above the threshold, i.e.
+    // how much the final clamp has to cut off
+    Limiter32N<BENCH_CHANS, BENCH_FS/1000> probe(-30.2, 0.001, 0.1, 1.0, BENCH_FS);
+    int32_t threshold, lookahead, hold, release;
+    Signal frame(BENCH_CHANS);
+    size_t clipped = 0;
+    double over = 1.;
+
+    probe.getFixedParams(threshold, lookahead, hold, release);
+    for (size_t n = 0; n < frames; n++)
+    {
+        bool clip = false;
+
+        std::copy(&in[n * BENCH_CHANS], &in[(n + 1) * BENCH_CHANS], frame.begin());
+        int32_t gain = probe.process(&frame[0]);
+        for (int c = 0; n >= (size_t) lookahead && c < BENCH_CHANS; c++)
+        {
+            double y = fabs((double) gain * in[(n - lookahead) * BENCH_CHANS + c] / 2147483648.);
+            clip |= y > threshold;
+            over = std::max(over, y / threshold);
+        }
+        clipped += clip;
+    }
+
+    report("LIMITER", kind, ns, out, "  %s attack, %lu frames clipped, max %.4f dB over",
+           LIMITER_ATTACK_AVERAGE ? "average" : "one-pole", (unsigned long) clipped,
+           20 * log10(over));
+}
+
+// lookahead window of 1 to 10 ms at 48 and 96 kHz: the peak deque and
+// the moving average must keep the cost per frame flat over the length
+#define WINDOW_MAX_FRAMES 960
+
+static void benchWindow(int kind, const Signal &in, size_t frames)
+{
+    static const double windows[] = { 0.001, 0.002, 0.005, 0.010 };
+    static const int32_t rates[] = { 48000, 96000 };
+    static Limiter32N<BENCH_CHANS, WINDOW_MAX_FRAMES> lim;
+
+    for (int r = 0; r < 2; r++)
+        for (int w = 0; w < 4; w++)
+        {
+            Signal out(in);
+            char name[24];
+
+            lim = Limiter32N<BENCH_CHANS, WINDOW_MAX_FRAMES>(-30.2, windows[w], 0.1, 1.0,
+                                                               rates[r]);
+
+            double ns = timeBlocks(frames, [&](size_t n) {
+                for (size_t k = n; k < n + BENCH_BLOCK; k++)
+                    lim.process(&out[k * BENCH_CHANS]);
+            });
+
+            snprintf(name, sizeof(name), "WINDOW %2.0fms %2dk", windows[w] * 1e3,
+                     (int) (rates[r] / 1000));
+            printf("%-16s %-8s %4d frames %8.2f ns/frame  crc %08x\n", name,
+                   signalNames[kind], (int) (windows[w] * rates[r]), ns,
+                   fingerprint(name, kind, out));
+        }
+}
+
+// Dynamics32 against Limiter32::process() per channel; the compressor is
+// also run with blocks of one frame, i.e. with a gain computation per sample
+static void benchDynamics(int kind, const Signal &in, size_t frames)
+{
+    static const char *names[] = { "COMPRESSOR", "GATE", "COMP 1/BLK", "LIMITER" };
+
+    for (int m = 0; m < 4; m++)
+    {
+        Dynamics32N<BENCH_CHANS> dyn(-30., 4., 6., 0.005, 0.1, BENCH_FS);
+        Limiter32N<BENCH_CHANS, BENCH_FS/1000> lim(-30.2, 0.001, 0.1, 1.0, BENCH_FS);
+        size_t block = m == 2 ? 1 : BENCH_BLOCK;
+        Signal out(in);
+
+        if (m == 1)
+        {
+            dyn.setCompressor(0., 1., 0.);
+            dyn.setExpander(-50., 10., 3.);
+            dyn.setRange(60.);
+        }
+
+        double ns = timeBlocks(frames, [&](size_t n) {
+            if (m == 3)
+                for (size_t k = n; k < n + BENCH_BLOCK; k++)
+                    lim.process(&out[k * BENCH_CHANS]);
+            else
+                for (size_t k = n; k < n + BENCH_BLOCK; k += block)
+                    dyn.processBlock(&out[k * BENCH_CHANS], block);
+        });
+
+        printf("%-12s %-8s %8.2f ns/frame  %6.2f ns/channel  crc %08x\n", names[m],
+               signalNames[kind], ns, ns / BENCH_CHANS, fingerprint(names[m], kind, out));
+    }
+}
+
+// 3 band compressor: null test with idle bands (output must equal the
+// input) and cost per band against one EQ32 biquad plus one Dynamics32
+static void benchMultiband(int kind, const Signal &in, size_t frames)
+{
+    static const double freqs[2] = { 200., 2000. };
+    double nsBiquad, nsDynamics;
+
+    {
+        MultibandDynamics<BENCH_CHANS, 3> mb;
+        Signal out(in);
+
+        mb.design(freqs, BENCH_FS);
+        for (size_t n = 0; n < frames; n += BENCH_BLOCK)
+            mb.processBlock(&out[n * BENCH_CHANS], BENCH_BLOCK);
+
+        printf("%-12s %-8s null test %s\n", "MULTIBAND", signalNames[kind],
+               expect(out == in) ? "passed" : "FAILED");
+    }
+
+    {
+        EQ32N<BENCH_CHANS> lp(LOW_PASS_EQ, 200., BENCH_FS, 0., 0.7071);
+        Dynamics32N<BENCH_CHANS> dyn(-30., 4., 6., 0.005, 0.1, BENCH_FS);
+        Signal out(in);
+
+        nsBiquad = timeBlocks(frames, [&](size_t n) {
+            lp.processBlock(&out[n * BENCH_CHANS], BENCH_BLOCK);
+        });
+        nsDynamics = timeBlocks(frames, [&](size_t n) {
+            dyn.processBlock(&out[n * BENCH_CHANS], BENCH_BLOCK);
+        });
+    }
+
+    {
+        MultibandDynamics<BENCH_CHANS, 3> mb;
+        Signal out(in);
+
+        mb.design(freqs, BENCH_FS);
+        for (int k = 0; k < 3; k++)
+            mb.band(k).setCompressor(-36., 3., 6.);
+
+        double ns = timeBlocks(frames, [&](size_t n) {
+            mb.processBlock(&out[n * BENCH_CHANS], BENCH_BLOCK);
+        });
+        printf("%-12s %-8s %8.2f ns/frame  %6.2f ns/band (biquad + dynamics %6.2f)"
+               "  crc %08x\n", "MULTIBAND", signalNames[kind], ns, ns / 3,
+               nsBiquad + nsDynamics, fingerprint("MULTIBAND", kind, out));
+    }
+}
+
+// FIR32 from 16 to 512 taps: exactness against a naive 64 bit sum over
+// the time-reversed history, ns per channel and sample, and the largest
+// tap count one (host) core could run at 48 kHz stereo from that rate
+#define FIR_MAX_TAPS 512
+
+static void benchFIR(int kind, const Signal &in, size_t frames)
+{
+    static FIR32<FIR_MAX_TAPS, BENCH_CHANS> fir;
+
+    for (int taps = 16; taps <= FIR_MAX_TAPS; taps *= 2)
+    {
+        std::vector<int32_t> h(taps);
+        Signal out(in);
+        int64_t mismatches = 0;
+
+        // windowed sinc low-pass at 4 kHz, linear phase
+        for (int k = 0; k < taps; k++)
+        {
+            double t = k - (taps - 1) / 2.;
+            double fc = 4000. / BENCH_FS;
+            double sinc = t == 0 ? 2 * fc : sin(2 * M_PI * fc * t) / (M_PI * t);
+            double w = 0.54 - 0.46 * cos(2 * M_PI * k / (taps - 1));
+            h[k] = (int32_t) (sinc * w * fixed_one);
+        }
+        fir.setCoefficients(&h[0], taps);
+
+        double ns = timeBlocks(frames, [&](size_t n) {
+            fir.processBlock(&out[n * BENCH_CHANS], BENCH_BLOCK);
+        }) / BENCH_CHANS;
+
+        for (size_t n = 0; n < frames; n++)
+            for (int c = 0; c < BENCH_CHANS; c++)
+            {
+                int64_t acc = 0;
+                for (int k = 0; k < taps && (size_t) k <= n; k++)
+                    acc += (int64_t) h[k] * in[(n - k) * BENCH_CHANS + c];
+                mismatches += (int32_t) (acc >> fractional_bits) != out[n * BENCH_CHANS + c];
+            }
+
+        char name[16];
+
+        snprintf(name, sizeof(name), "FIR %d", taps);
+        printf("FIR %4d     %-8s %8.2f ns/sample  %5.3f ns/tap  max %6.0f taps  crc %08x  %s\n",
+               taps, signalNames[kind], ns, ns / taps,
+               1e9 / (BENCH_FS * BENCH_CHANS) / (ns / taps),
+               fingerprint(name, kind, out), expect(mismatches == 0) ? "exact" : "MISMATCH");
+    }
+}
+
+// EQ of the cppdsp chain
+static const BiquadParams chainParams[5] = {
+    {PEAKING_EQ,    55.0,   11.0, 1.0 },
+    {PEAKING_EQ,    55.0,   11.0, 1.0 },
+    {HIGH_PASS_EQ,  40.0,   0.0,  0.85},
+    {HIGH_PASS_EQ,  40.0,   0.0,  0.85},
+    {HIGH_SHELF_EQ, 8000.0, 3.0,  0.71}
+};
+
+static void benchChain(int kind, const Signal &in, size_t frames)
+{
+    // hand-written, as cppdsp_process_block() before the graph
+    {
+        BiquadCascade<5, BENCH_CHANS> eq(chainParams, BENCH_FS);
+        Limiter32N<BENCH_CHANS, BENCH_FS/1000> lim(-30.2, 0.001, 0.1, 1.0, BENCH_FS);
+        Signal out(in);
+
+        double ns = timeBlocks(frames, [&](size_t n) {
+            int32_t *block = &out[n * BENCH_CHANS];
+            for (int i = 0; i < BENCH_BLOCK * BENCH_CHANS; i++)
+                block[i] >>= 4;
+            eq.processBlock(block, BENCH_BLOCK);
+            for (int k = 0; k < BENCH_BLOCK; k++)
+                lim.process(&block[k * BENCH_CHANS]);
+            for (int i = 0; i < BENCH_BLOCK * BENCH_CHANS; i++)
+                block[i] <<= 5;
+        });
+
+        report("CHAIN", kind, ns, out);
+    }
+
+    // the same chain as a graph
+    {
+        GainNode<BENCH_CHANS> inGain(DSP_GAIN_ONE, -4);
+        BiquadNode<5, BENCH_CHANS> eq(chainParams, BENCH_FS);
+        LimiterNode<BENCH_CHANS, BENCH_FS/1000> lim(-30.2, 0.001, 0.1, 1.0, BENCH_FS);
+        GainNode<BENCH_CHANS> outGain(DSP_GAIN_ONE, 5);
+        DspGraph<4, 0, BENCH_CHANS, BENCH_BLOCK> graph;
+        Signal out(in);
+
+        graph.addNode(inGain, 0, 0);
+        graph.addNode(eq, 0, 0);
+        graph.addNode(lim, 0, 0);
+        graph.addNode(outGain, 0, 0);
+        graph.compile();
+
+        double ns = timeBlocks(frames, [&](size_t n) {
+            graph.process(&out[n * BENCH_CHANS], BENCH_BLOCK);
+        });
+
+        report("GRAPH", kind, ns, out);
+    }
+}
+
+// DelayNode and MixerNode in a graph with scratch blocks: block 0 is
+// delayed by NODE_DELAY into block 1 and by the maximum delay into block 2,
+// the mixer sums all three back into block 0
+#define NODE_DELAY      7
+#define NODE_MAX_DELAY  64
+
+static void benchNodes(int kind, const Signal &in, size_t frames)
+{
+    const size_t samples = frames * BENCH_CHANS;
+    const int32_t gains[3] = { DSP_GAIN_ONE, DSP_GAIN_ONE / 3, -3 * (DSP_GAIN_ONE / 4) };
+    const int inputs[3] = { 0, 1, 2 };
+
+    // delay 0 is a copy, the maximum delay shifts the input by MaxDelay frames
+    for (int d = 0; d < 2; d++)
+    {
+        int delay = d ? NODE_MAX_DELAY : 0;
+        DelayNode<BENCH_CHANS, NODE_MAX_DELAY> node(delay);
+        Signal out(in);
+        bool same = true;
+        char name[16];
+
+        for (size_t n = 0; n < frames; n += BENCH_BLOCK)
+        {
+            int32_t *const blockIn[1] = { &out[n * BENCH_CHANS] };
+            node.processBlock(blockIn, blockIn[0], BENCH_BLOCK);
+        }
+        for (size_t i = 0; i < samples; i++)
+            same &= out[i] == (i < (size_t) delay * BENCH_CHANS ? 0 :
+                               in[i - delay * BENCH_CHANS]);
+
+        snprintf(name, sizeof(name), "DELAY %d", delay);
+        printf("%-12s %-8s crc %08x  %s\n", name, signalNames[kind],
+               fingerprint(name, kind, out), expect(same) ? "exact" : "MISMATCH");
+    }
+
+    // mixer sum against an exact 128 bit sum of the same products
+    {
+        DelayNode<BENCH_CHANS, NODE_MAX_DELAY> shortDelay(NODE_DELAY), longDelay(NODE_MAX_DELAY);
+        MixerNode<BENCH_CHANS, 3> mixer;
+        DspGraph<3, 2, BENCH_CHANS, BENCH_BLOCK> graph;
+        Signal out(in);
+        int64_t maxError = 0;
+
+        for (int k = 0; k < 3; k++)
+            mixer.setGain(k, gains[k]);
+        graph.addNode(shortDelay, 0, 1);
+        graph.addNode(longDelay, 0, 2);
+        graph.addNode(mixer, inputs, 0);
+        graph.compile();
+
+        double ns = timeBlocks(frames, [&](size_t n) {
+            graph.process(&out[n * BENCH_CHANS], BENCH_BLOCK);
+        });
+
+        for (size_t i = 0; i < samples; i++)
+        {
+            const size_t delays[3] = { 0, NODE_DELAY * BENCH_CHANS, NODE_MAX_DELAY * BENCH_CHANS };
+            __int128 acc = 0;
+
+            for (int k = 0; k < 3; k++)
+                if (i >= delays[k])
+                    acc += (__int128) gains[k] * in[i - delays[k]];
+            acc >>= 30;
+            int64_t ref = acc > INT32_MAX ? INT32_MAX : acc < INT32_MIN ? INT32_MIN : (int64_t) acc;
+            maxError = std::max(maxError, (int64_t) std::abs(ref - out[i]));
+        }
+
+        report("MIXER", kind, ns, out, "  max error %lld LSB%s", (long long) maxError,
+               expect(maxError <= 1) ? "" : "  FAIL");
+    }
+
+    // four full-scale inputs at the largest gains must saturate, not wrap
+    {
+        MixerNode<BENCH_CHANS, 4> mixer;
+        int32_t lo[BENCH_CHANS], hi[BENCH_CHANS], out[BENCH_CHANS];
+        int32_t *const allLow[4] = { lo, lo, lo, lo };
+        int32_t *const allHigh[4] = { hi, hi, hi, hi };
+        bool ok;
+
+        for (int c = 0; c < BENCH_CHANS; c++)
+        {
+            lo[c] = INT32_MIN;
+            hi[c] = INT32_MAX;
+        }
+        for (int k = 0; k < 4; k++)
+            mixer.setGain(k, INT32_MIN);
+
+        mixer.processBlock(allLow, out, 1);
+        ok = out[0] == INT32_MAX && out[BENCH_CHANS - 1] == INT32_MAX;
+        mixer.processBlock(allHigh, out, 1);
+        ok &= out[0] == INT32_MIN && out[BENCH_CHANS - 1] == INT32_MIN;
+
+        printf("%-12s %-8s 4 inputs at gain -2.0 and full scale %s\n", "MIXER SAT",
+               signalNames[kind], expect(ok) ? "saturate" : "WRAP");
+    }
+}
+
+// 2 inputs x 4 bands = 8 outputs at 48 and 96 kHz, the load is the share
+// of the frame period at that rate
+#define XOVER_BANDS     4
+
+static void benchCrossover(int kind, const Signal &in, size_t frames)
+{
+    static const double freqs[XOVER_BANDS - 1] = { 120., 1200., 5000. };
+    static const int orders[] = { LR2, LR4, LR8 };
+    static const double rates[] = { 48000., 96000. };
+    const int outChans = BENCH_CHANS * XOVER_BANDS;
+
+    for (int r = 0; r < 2; r++)
+        for (int o = 0; o < 3; o++)
+        {
+            LRCrossover<BENCH_CHANS, XOVER_BANDS> xover;
+            Signal out(frames * outChans);
+            char name[16];
+
+            xover.design(orders[o], freqs, rates[r]);
+
+            double ns = timeBlocks(frames, [&](size_t n) {
+                xover.processBlock(&in[n * BENCH_CHANS], BENCH_CHANS,
+                                   &out[n * outChans], BENCH_BLOCK);
+            });
+
+            // per output: the low-pass/high-pass stages plus the allpasses
+            int sections = orders[o] / 2, allpass = orders[o] == LR8 ? 2 : 1;
+            int biquads = BENCH_CHANS * ((XOVER_BANDS - 1) * 2 * sections +
+                          (XOVER_BANDS - 1) * (XOVER_BANDS - 2) / 2 * allpass);
+
+            char key[24];
+
+            snprintf(name, sizeof(name), "XOVER LR%d", orders[o]);
+            snprintf(key, sizeof(key), "%s %.0fk", name, rates[r] / 1000.);
+            printf("%-12s %-8s %3.0f kHz %8.2f ns/frame  %2d biquads  load %5.2f%%"
+                   "  crc %08x\n", name, signalNames[kind], rates[r] / 1000., ns,
+                   biquads, ns * rates[r] * 1e-7, fingerprint(key, kind, out));
+        }
+}
+
+// typical 8 band preset with half of the bands at 0 dB
+static const BiquadParams flatParams[8] = {
+    {HIGH_PASS_EQ,  30.0,   0.0,  0.71},
+    {PEAKING_EQ,    60.0,   0.0,  1.0 },
+    {PEAKING_EQ,    125.0,  4.0,  1.0 },
+    {LOW_SHELF_EQ,  250.0,  0.0,  0.71},
+    {PEAKING_EQ,    1000.0, -3.0, 1.4 },
+    {PEAKING_EQ,    2000.0, 0.0,  1.0 },
+    {HIGH_SHELF_EQ, 8000.0, 3.0,  0.71},
+    {GAIN_EQ,       1000.0, 0.0,  0.71}
+};
+
+// stage 2 of flatParams goes flat (0 dB) for the second quarter of the
+// signal and back; the classified kernels must keep the history of the
+// flat stage like the full kernel, or it clicks when it filters again.
+// The reference runs the flat stretch on identity coefficients, which is
+// what the classifier makes of the 0 dB design; TOGGLE 0dB shows how long
+// the real design takes to get there
+#define TOGGLE_STAGE 2
+
+static bool toggleFlat(size_t n, size_t frames)
+{
+    return n >= frames / 4 && n < frames / 2;
+}
+
+static void benchToggle(int kind, const Signal &in, size_t frames)
+{
+    BiquadParams flat = flatParams[TOGGLE_STAGE];
+    int32_t coeffs[8][BIQUAD_COEFFS], flatCoeffs[BIQUAD_COEFFS];
+    const int32_t identity[BIQUAD_COEFFS] = { fixed_one, 0, 0, 0, 0 };
+    uint32_t crcFull;
+
+    flat.gain = 0.;
+    EQ32Base(flat.type, flat.f0, BENCH_FS, flat.gain, flat.Q).getNewCoefficients(flatCoeffs);
+    for (int s = 0; s < 8; s++)
+        EQ32Base(flatParams[s].type, flatParams[s].f0, BENCH_FS,
+                 flatParams[s].gain, flatParams[s].Q).getNewCoefficients(coeffs[s]);
+
+    // the full kernel on identity coefficients for the flat stretch, and
+    // on the real 0 dB design
+    Signal ref[2];
+    for (int r = 0; r < 2; r++)
+    {
+        int32_t states[8][BENCH_CHANS][BIQUAD_STATES] = {{{0}}};
+
+        ref[r] = in;
+        for (size_t n = 0; n < frames; n++)
+            for (int c = 0; c < BENCH_CHANS; c++)
+                for (int s = 0; s < 8; s++)
+                {
+                    const int32_t *k = s == TOGGLE_STAGE && toggleFlat(n, frames) ?
+                                       (r == 0 ? identity : flatCoeffs) : coeffs[s];
+                    int32_t &x = ref[r][n * BENCH_CHANS + c];
+                    x = biquadSample<ERROR_FEEDBACK != 0>(k, states[s][c], x, BIQUAD_FULL);
+                }
+    }
+    crcFull = fingerprint("TOGGLE FULL", kind, ref[0]);
+
+    // the bypass equals the 0 dB design only in the steady state: the
+    // design still rings out the stage's previous response, and its
+    // truncation has a bias that the poles near z = 1 turn into a small
+    // DC offset, which the bypass does not have. Steady is the largest
+    // difference over the last quarter of the flat stretch
+    {
+        const size_t start = frames / 4, end = frames / 2;
+        size_t settled = start;
+        int32_t maxDiff = 0, steady = 0;
+
+        for (size_t n = start; n < end; n++)
+            for (int c = 0; c < BENCH_CHANS; c++)
+            {
+                int32_t diff = std::abs(ref[0][n * BENCH_CHANS + c] - ref[1][n * BENCH_CHANS + c]);
+                maxDiff = std::max(maxDiff, diff);
+                if (n >= end - (end - start) / 4)
+                    steady = std::max(steady, diff);
+            }
+        for (size_t n = start; n < end; n++)
+            for (int c = 0; c < BENCH_CHANS; c++)
+                if (std::abs(ref[0][n * BENCH_CHANS + c] - ref[1][n * BENCH_CHANS + c]) >
+                    2 * steady + 1)
+                    settled = n + 1;
+
+        double steadyDb = 20 * log10((steady + 1) / 2147483648.0);
+        printf("%-12s %-8s bypass against the 0 dB design: max %d LSB, %lu frames to a "
+               "steady %d LSB (%.0f dBFS)%s\n", "TOGGLE 0dB", signalNames[kind], maxDiff,
+               (unsigned long) (settled - start), steady, steadyDb,
+               expect(steadyDb < -100.) ? "" : "  FAILED");
+    }
+
+    {
+        BiquadCascade<8, BENCH_CHANS> eq(flatParams, BENCH_FS);
+        Signal out(in);
+
+        for (size_t n = 0; n < frames; n += BENCH_BLOCK)
+        {
+            if (n == frames / 4)
+                eq.setStageCoefficients(TOGGLE_STAGE, flatCoeffs);
+            if (n == frames / 2)
+                eq.setStageCoefficients(TOGGLE_STAGE, coeffs[TOGGLE_STAGE]);
+            eq.processBlock(&out[n * BENCH_CHANS], BENCH_BLOCK);
+        }
+
+        uint32_t crc = fingerprint("TOGGLE CASCADE", kind, out);
+        printf("%-12s %-8s crc %08x  stage %d flat and back%s\n", "TOGGLE CASCADE",
+               signalNames[kind], crc, TOGGLE_STAGE,
+               expect(crc == crcFull) ? ", same as the full kernel" : "  MISMATCH");
+    }
+
+    {
+        EQ32N<BENCH_CHANS> eq[8];
+        Signal out(in);
+
+        for (int s = 0; s < 8; s++)
+        {
+            eq[s].setType(flatParams[s].type, 0);
+            eq[s].setCenterFrequency(flatParams[s].f0, 0);
+            eq[s].setSamplingFrequency(BENCH_FS, 0);
+            eq[s].setGain(flatParams[s].gain, 0);
+            eq[s].setQfactor(flatParams[s].Q);
+        }
+
+        for (size_t n = 0; n < frames; n += BENCH_BLOCK)
+        {
+            if (n == frames / 4)
+                eq[TOGGLE_STAGE].setGain(0.);
+            if (n == frames / 2)
+                eq[TOGGLE_STAGE].setGain(flatParams[TOGGLE_STAGE].gain);
+            for (int s = 0; s < 8; s++)
+                eq[s].processBlock(&out[n * BENCH_CHANS], BENCH_BLOCK);
+        }
+
+        uint32_t crc = fingerprint("TOGGLE EQ32N", kind, out);
+        printf("%-12s %-8s crc %08x  stage %d flat and back%s\n", "TOGGLE EQ32N",
+               signalNames[kind], crc, TOGGLE_STAGE,
+               expect(crc == crcFull) ? ", same as the full kernel" : "  MISMATCH");
+    }
+}
+
+// classified cascade and EQ32N stages against every stage on the full
+// biquad kernel; equal outputs show that skipping flat stages is exact
+static void benchFlat(int kind, const Signal &in, size_t frames)
+{
+    Signal full;
+
+    {
+        int32_t coeffs[8][BIQUAD_COEFFS];
+        int32_t states[8][BENCH_CHANS][BIQUAD_STATES] = {{{0}}};
+        Signal out(in);
+
+        for (int s = 0; s < 8; s++)
+        {
+            EQ32Base eq(flatParams[s].type, flatParams[s].f0, BENCH_FS,
+                        flatParams[s].gain, flatParams[s].Q);
+            eq.getNewCoefficients(coeffs[s]);
+        }
+
+        double ns = timeBlocks(frames, [&](size_t n) {
+            int32_t *block = &out[n * BENCH_CHANS];
+            for (int k = 0; k < BENCH_BLOCK * BENCH_CHANS; k++)
+                for (int s = 0; s < 8; s++)
+                    block[k] = biquadSample<ERROR_FEEDBACK != 0>(coeffs[s],
+                               states[s][k % BENCH_CHANS], block[k], BIQUAD_FULL);
+        });
+
+        report("FLAT FULL", kind, ns, out, "  8 of 8 stages");
+        full = out;
+    }
+
+    {
+        BiquadCascade<8, BENCH_CHANS> eq(flatParams, BENCH_FS);
+        Signal out(in);
+
+        double ns = timeBlocks(frames, [&](size_t n) {
+            eq.processBlock(&out[n * BENCH_CHANS], BENCH_BLOCK);
+        });
+
+        report("FLAT CASCADE", kind, ns, out, "  %d of 8 stages%s", eq.getRunStages(),
+               expect(out == full) ? "" : "  MISMATCH");
+    }
+
+    {
+        EQ32N<BENCH_CHANS> eq[8];
+        Signal out(in);
+        int run = 0;
+
+        for (int s = 0; s < 8; s++)
+        {
+            eq[s].setType(flatParams[s].type, 0);
+            eq[s].setCenterFrequency(flatParams[s].f0, 0);
+            eq[s].setSamplingFrequency(BENCH_FS, 0);
+            eq[s].setGain(flatParams[s].gain, 0);
+            eq[s].setQfactor(flatParams[s].Q);
+        }
+
+        double ns = timeBlocks(frames, [&](size_t n) {
+            for (int s = 0; s < 8; s++)
+                eq[s].processBlock(&out[n * BENCH_CHANS], BENCH_BLOCK);
+        });
+
+        for (int s = 0; s < 8; s++)
+            run += eq[s].getKind() != BIQUAD_BYPASS;
+
+        report("FLAT EQ32N", kind, ns, out, "  %d of 8 stages%s", run,
+               expect(out == full) ? "" : "  MISMATCH");
+    }
+
+    benchToggle(kind, in, frames);
+}
+
+// a cascade that shows its coefficients while they are ramped
+template <int NumStages>
+class RampProbe : public BiquadCascade<NumStages, 1>
+{
+public:
+    const int32_t *stageCoefficients(int s) const { return this->stages[s].coefficients; }
+    bool ramping(void) const { return this->rampRemaining > 0; }
+};
+
+// inside |a2| < 1, |a1| < 1 + a2
+static bool stableFeedback(const int32_t c[BIQUAD_COEFFS])
+{
+    int64_t a1 = -(int64_t) c[3], a2 = -(int64_t) c[4];
+
+    return a2 < fixed_one && a2 > -fixed_one && (a1 < 0 ? -a1 : a1) < fixed_one + a2;
+}
+
+#define RAMP_LENGTHS    4
+
+static const int32_t rampLengths[RAMP_LENGTHS] = { 0, 64, 256, 1024 };
+
+// energy above 4 kHz in the 50 ms after a 100 Hz peaking EQ is switched
+// from +12 to -12 dB on a 100 Hz sine (4th order high pass in double),
+// relative to the energy of the sine, for a step and ramps
+static double clickEnergy(int32_t rampLength)
+{
+    const size_t frames = BENCH_FS / 2, change = BENCH_FS / 4, window = BENCH_FS / 20;
+    const double amp = 0.5 * 2147483647.0 / (1 << HEADROOM_BITS);
+    BiquadCascade<1, 1> eq;
+    double hp[BIQUAD_COEFFS], st[2][4] = {{0}};
+    double click = 0, sine = 0;
+
+    EQ32Base(HIGH_PASS_EQ, 4000., BENCH_FS, 0., 0.7071).getNewCoefficients(hp);
+    eq.designStage(0, PEAKING_EQ, 100., BENCH_FS, 12., 1.4);
+    eq.setRampLength(rampLength);
+
+    for (size_t n = 0; n < frames; n += BENCH_BLOCK)
+    {
+        int32_t block[BENCH_BLOCK];
+
+        if (n == change)
+            eq.designStage(0, PEAKING_EQ, 100., BENCH_FS, -12., 1.4);
+
+        for (int k = 0; k < BENCH_BLOCK; k++)
+            block[k] = (int32_t) (amp * sin(2 * M_PI * 100. * (n + k) / BENCH_FS));
+        eq.processBlock(block, BENCH_BLOCK);
+
+        for (int k = 0; k < BENCH_BLOCK; k++)
+        {
+            double y = block[k];
+
+            for (int s = 0; s < 2; s++)
+            {
+                double x = y;
+                y = hp[0] * x + hp[1] * st[s][0] + hp[2] * st[s][1]
+                  + hp[3] * st[s][2] + hp[4] * st[s][3];
+                st[s][1] = st[s][0];
+                st[s][0] = x;
+                st[s][3] = st[s][2];
+                st[s][2] = y;
+            }
+            if (n + k >= change && n + k < change + window)
+            {
+                click += y * y;
+                sine += amp * amp / 2;
+            }
+        }
+    }
+    return 10 * log10(click / sine);
+}
+
+// ramped coefficient updates of BiquadCascade: click energy of a large EQ
+// move, the cost of the chain EQ while it ramps all the time and the
+// feedback of every intermediate set between designs with poles close to
+// z = 1, where truncated steps drift over the edge without the clamp
+static void benchRamp(void)
+{
+    static const BiquadParams edge[4] = {
+        {HIGH_PASS_EQ,  10.0,   0.0,  0.5 },
+        {LOW_SHELF_EQ,  12.0,  -18.0, 4.0 },
+        {PEAKING_EQ,    20.0,   15.0, 8.0 },
+        {HIGH_PASS_EQ,  15.0,   0.0,  6.0 }
+    };
+    const size_t frames = BENCH_FS;
+    double stepEnergy = clickEnergy(0);
+    int failed = 0;
+    Signal in;
+
+    for (int r = 0; r < RAMP_LENGTHS; r++)
+    {
+        double e = r == 0 ? stepEnergy : clickEnergy(rampLengths[r]);
+
+        if (r == 0)
+            printf("%-12s %4d frames  click %7.1f dB\n", "RAMP", rampLengths[r], e);
+        else
+            printf("%-12s %4d frames  click %7.1f dB  %5.1f dB below the step%s\n", "RAMP",
+                   rampLengths[r], e, stepEnergy - e,
+                   expect(e < stepEnergy - 6.) ? "" : "  FAILED");
+    }
+
+    // the chain EQ alternating between two settings, a new ramp each time
+    // the last one has ended (every 1024 frames for the step)
+    generate(PINK, in, frames);
+    for (int r = 0; r < RAMP_LENGTHS; r++)
+    {
+        BiquadCascade<5, BENCH_CHANS> eq(chainParams, BENCH_FS);
+        int32_t interval = rampLengths[r] > 0 ? rampLengths[r] : 1024;
+        double ticks = 0;
+        Signal out(in);
+
+        // the designs are not timed
+        eq.setRampLength(rampLengths[r]);
+        for (size_t n = 0; n < frames; n += BENCH_BLOCK)
+        {
+            if (n % interval == 0)
+                eq.designStage(0, PEAKING_EQ, 55., BENCH_FS, (n / interval) % 2 ? 11. : 3., 1.);
+
+            ticks += timeCall([&] { eq.processBlock(&out[n * BENCH_CHANS], BENCH_BLOCK); });
+        }
+        printf("%-12s %4d frames  BiquadCascade<5,2> %6.2f ns/frame\n", "RAMP COST",
+               rampLengths[r], ticks / frames);
+    }
+
+    // every pair of the edge designs, both directions
+    for (int a = 0; a < 4; a++)
+        for (int b = 0; b < 4; b++)
+        {
+            RampProbe<1> eq;
+            int32_t block[BENCH_BLOCK] = {0};
+            int sets = 0, unstable = 0;
+
+            if (a == b)
+                continue;
+
+            eq.designStage(0, edge[a].type, edge[a].f0, BENCH_FS, edge[a].gain, edge[a].Q);
+            eq.processBlock(block, BENCH_BLOCK);
+            eq.setRampLength(4096);
+            eq.designStage(0, edge[b].type, edge[b].f0, BENCH_FS, edge[b].gain, edge[b].Q);
+            do
+            {
+                eq.processBlock(block, BENCH_BLOCK);
+                unstable += !stableFeedback(eq.stageCoefficients(0));
+                sets++;
+            }
+            while (eq.ramping());
+
+            if (unstable)
+                printf("%-12s %s %.0f Hz -> %s %.0f Hz  %d of %d sets unstable  FAILED\n",
+                       "RAMP EDGE", typeNames[edge[a].type], edge[a].f0,
+                       typeNames[edge[b].type], edge[b].f0, unstable, sets);
+            failed += !expect(unstable == 0);
+        }
+    printf("%-12s 12 ramps between designs at 10-20 Hz, %s\n", "RAMP EDGE",
+           failed ? "FAILED" : "every set stable");
+
+    // construct, setRampLength, process: the designed filter is in effect
+    // from the first frame, nothing is ramped in from the memory the object
+    // was built in (filled with a pattern here)
+    {
+        static int64_t memory[sizeof(EQ32N<BENCH_CHANS>) / sizeof(int64_t) + 1];
+        memset(memory, 0x55, sizeof(memory));
+        EQ32N<BENCH_CHANS> *ramped = new (memory) EQ32N<BENCH_CHANS>(PEAKING_EQ, 55., BENCH_FS,
+                                                                     11., 1.);
+        EQ32N<BENCH_CHANS> direct(PEAKING_EQ, 55., BENCH_FS, 11., 1.);
+        Signal outRamped(in), outDirect(in);
+
+        ramped->setRampLength(256);
+        for (size_t n = 0; n < frames; n += BENCH_BLOCK)
+        {
+            ramped->processBlock(&outRamped[n * BENCH_CHANS], BENCH_BLOCK);
+            direct.processBlock(&outDirect[n * BENCH_CHANS], BENCH_BLOCK);
+        }
+        printf("%-12s ramp length set after construction: %s\n", "RAMP START",
+               expect(outRamped == outDirect) ? "designed filter from the first frame" :
+                                                "FAILED");
+        ramped->~EQ32N<BENCH_CHANS>();
+    }
+}
+
+static void benchDesign(void)
+{
+    const int redesigns = 100000;
+    EQ32Base eq(PEAKING_EQ, 1000., BENCH_FS, 0., 0.7071);
+
+    // sweep all parameters so that no result can be reused
+    double nsDesign = (double) timeCall([&] {
+        for (int i = 0; i < redesigns; i++)
+        {
+            eq.setCenterFrequency(20. + (i % 1000) * 20., 0);
+            eq.setGain(-24. + (i % 97) * 0.5, 0);
+            eq.setQfactor(0.1 + (i % 50) * 0.5);
+        }
+    }) / redesigns;
+    printf("%-12s %8.2f ns/redesign\n", "designEQ", nsDesign);
+
+    // the same sweep from integer parameters, no floating point with
+    // EQ32_FIXED_DESIGN
+    double nsInt = (double) timeCall([&] {
+        for (int i = 0; i < redesigns; i++)
+            eq.designEQInt(PEAKING_EQ, 20 + (i % 1000) * 20, BENCH_FS, -2400 + (i % 97) * 50,
+                           100 + (i % 50) * 500);
+    }) / redesigns;
+    printf("%-12s %8.2f ns/redesign, %.2f x as fast as designEQ\n", "designEQInt",
+           nsInt, nsDesign / nsInt);
+
+    // against designEQ() from the same values as doubles
+    int32_t maxDiff = 0;
+    for (int type = GAIN_EQ; type <= ALLPASS_EQ; type++)
+        for (int i = 0; i < 200; i++)
+        {
+            int32_t f0Hz = 20 + i * 99, gainCdB = -2400 + (i * 37) % 4801;
+            int32_t qMilli = 500 + (i * 53) % 9500;
+            int32_t a[BIQUAD_COEFFS], b[BIQUAD_COEFFS];
+
+            EQ32Base(type, f0Hz, BENCH_FS, gainCdB / 100., qMilli / 1000.).getNewCoefficients(a);
+            eq.designEQInt(type, f0Hz, BENCH_FS, gainCdB, qMilli);
+            eq.getNewCoefficients(b);
+            for (int k = 0; k < BIQUAD_COEFFS; k++)
+                maxDiff = std::max(maxDiff, std::abs(a[k] - b[k]));
+        }
+    printf("%-12s max %d LSB from designEQ over all types%s\n", "designEQInt", maxDiff,
+           expect(maxDiff <= 8) ? "" : "  FAILED");
+
+    // f0, gain and Q stay table positions until they are asked for, so
+    // nothing of this loop is floating point (soft-float on the XS1)
+    double nsTable = (double) timeCall([&] {
+        for (int i = 0; i < redesigns; i++)
+            eq.designEQTable(PEAKING_EQ,
+                             (i * 37) % ((EQ32_FREQ_STEPS - 1) << EQ32_TABLE_FRAC_BITS),
+                             (i * 11) % ((EQ32_GAIN_STEPS - 1) << EQ32_TABLE_FRAC_BITS),
+                             (i * 5) % ((EQ32_Q_STEPS - 1) << EQ32_TABLE_FRAC_BITS));
+    }) / redesigns;
+    printf("%-12s %8.2f ns/redesign, %.2f x as fast as designEQ, tables %u bytes\n",
+           "designEQTable", nsTable, nsDesign / nsTable,
+           (unsigned) (sizeof(eq32FreqTable) + sizeof(eq32GainTable) + sizeof(eq32QTable)));
+
+    // positions from integer parameters, back through the getters
+    static const struct { int32_t f0Hz, gainCdB, qMilli; } params[] = {
+        { 20, -2400, 100 }, { 55, 1100, 1000 }, { 1000, 0, 707 }, { 8000, 300, 710 },
+        { 20000, 2400, 28000 }
+    };
+    bool close = true;
+    for (size_t i = 0; i < sizeof(params) / sizeof(params[0]); i++)
+    {
+        eq.designEQTable(PEAKING_EQ, eq32FreqPos(params[i].f0Hz, BENCH_FS),
+                         eq32GainPos(params[i].gainCdB), eq32QPos(params[i].qMilli));
+        close = close && fabs(eq.getCenterFrequency() / params[i].f0Hz - 1.) < 1e-3
+                      && fabs(eq.getGain() - params[i].gainCdB / 100.) < 0.01
+                      && fabs(eq.getQfactor() / (params[i].qMilli / 1000.) - 1.) < 1e-3;
+    }
+    printf("%-12s f0, gain and Q through the table positions: %s\n", "designEQTable",
+           expect(close) ? "within 0.1%" : "FAILED");
+}
+
+// static data of the cppdsp chain objects; all storage is inside the
+// objects, so this is what the xcc -report data figure grows by (less
+// 4 bytes per vtable pointer on the 32 bit target)
+static void benchMemory(void)
+{
+    static const struct {
+        const char *name;
+        size_t bytes;
+        size_t lookahead;
+    } objects[] = {
+        { "Limiter32N<2,48>",       sizeof(Limiter32N<2, 48>),       48 * 2 * sizeof(int32_t) },
+        { "Limiter32N<2,96>",       sizeof(Limiter32N<2, 96>),       96 * 2 * sizeof(int32_t) },
+        { "LimiterNode<2,48>",      sizeof(LimiterNode<2, 48>),      48 * 2 * sizeof(int32_t) },
+        { "BiquadCascade<5,2>",     sizeof(BiquadCascade<5, 2>),     0 },
+        { "BiquadNode<5,2>",        sizeof(BiquadNode<5, 2>),        0 },
+        { "GainNode<2>",            sizeof(GainNode<2>),             0 },
+        { "EQ32N<2>",               sizeof(EQ32N<2>),                0 },
+        { "Dynamics32N<2>",         sizeof(Dynamics32N<2>),          0 },
+        { "MultibandDynamics<2,3>", sizeof(MultibandDynamics<2, 3>), 0 },
+        { "DspGraph<8,0,2,64>",     sizeof(DspGraph<8, 0, 2, 64>),   0 },
+        { "DspGraph<8,2,2,64>",     sizeof(DspGraph<8, 2, 2, 64>),   0 },
+    };
+
+    for (size_t i = 0; i < sizeof(objects) / sizeof(objects[0]); i++)
+        printf("%-12s %-24s %6lu bytes, lookahead %4lu bytes\n", "MEMORY", objects[i].name,
+               (unsigned long) objects[i].bytes, (unsigned long) objects[i].lookahead);
+}
+
+static void benchEQTypes(int kind, const Signal &in, size_t frames)
+{
+    for (int type = GAIN_EQ; type <= ALLPASS_EQ; type++)
+        benchEQ(type, kind, in, frames);
+}
+
+struct Bench {
+    const char *name;
+    void (*perSignal)(int kind, const Signal &in, size_t frames);
+    void (*once)(void);
+};
+
+static const Bench benches[] = {
+    { "eq",        benchEQTypes,   0 },
+    { "block",     benchBlock,     0 },
+    { "template",  benchTemplate,  0 },
+    { "noise",     benchNoise,     0 },
+    { "limiter",   benchLimiter,   0 },
+    { "window",    benchWindow,    0 },
+    { "dynamics",  benchDynamics,  0 },
+    { "multiband", benchMultiband, 0 },
+    { "fir",       benchFIR,       0 },
+    { "chain",     benchChain,     0 },
+    { "nodes",     benchNodes,     0 },
+    { "crossover", benchCrossover, 0 },
+    { "flat",      benchFlat,      0 },
+    { "ramp",      0,              benchRamp },
+    { "divide",    0,              benchDivide },
+    { "design",    0,              benchDesign },
+    { "memory",    0,              benchMemory },
+};
+
+#define NUM_BENCHES (int) (sizeof(benches) / sizeof(benches[0]))
+
+static void usage(void)
+{
+    fprintf(stderr, "usage: dspbench [seconds] [bench ...]\n"
+                    "       dspbench -check file | -golden file\n"
+                    "benches:");
+    for (int b = 0; b < NUM_BENCHES; b++)
+        fprintf(stderr, " %s", benches[b].name);
+    fprintf(stderr, "\n");
+}
+
+// compares results with the golden file, returns the number of mismatches
+static int checkResults(const char *name)
+{
+    std::map<std::string, uint32_t> golden;
+    char key[64];
+    unsigned crc;
+    int errors = 0;
+    FILE *f = fopen(name, "r");
+
+    if (!f)
+    {
+        fprintf(stderr, "dspbench: cannot read %s\n", name);
+        return 1;
+    }
+    while (fscanf(f, "%63s %x", key, &crc) == 2)
+        golden[key] = crc;
+    fclose(f);
+
+    for (std::map<std::string, uint32_t>::const_iterator r = results.begin();
+         r != results.end(); ++r)
+    {
+        std::map<std::string, uint32_t>::const_iterator g = golden.find(r->first);
+
+        if (g == golden.end())
+        {
+            printf("check: %s has no golden CRC\n", r->first.c_str());
+            errors++;
+        }
+        else if (g->second != r->second)
+        {
+            printf("check: %s crc %08x, expected %08x\n", r->first.c_str(),
+                   r->second, g->second);
+            errors++;
+        }
+    }
+
+    for (std::map<std::string, uint32_t>::const_iterator g = golden.begin();
+         g != golden.end(); ++g)
+        if (results.find(g->first) == results.end())
+        {
+            printf("check: %s was not run\n", g->first.c_str());
+            errors++;
+        }
+
+    return errors;
+}
+
+static int writeResults(const char *name)
+{
+    FILE *f = fopen(name, "w");
+
+    if (!f)
+    {
+        fprintf(stderr, "dspbench: cannot write %s\n", name);
+        return 1;
+    }
+    for (std::map<std::string, uint32_t>::const_iterator r = results.begin();
+         r != results.end(); ++r)
+        fprintf(f, "%s %08x\n", r->first.c_str(), r->second);
+    fclose(f);
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *checkFile = 0, *goldenFile = 0;
+    bool selected[NUM_BENCHES];
+    bool any = false;
+    int seconds = 10;
+    Signal sig;
+
+    for (int b = 0; b < NUM_BENCHES; b++)
+        selected[b] = false;
+
+    for (int arg = 1; arg < argc; arg++)
+    {
+        int b = 0;
+
+        if ((strcmp(argv[arg], "-check") == 0 || strcmp(argv[arg], "-golden") == 0) &&
+            arg + 1 < argc)
+        {
+            if (argv[arg][1] == 'c')
+                checkFile = argv[arg + 1];
+            else
+                goldenFile = argv[arg + 1];
+            arg++;
+            continue;
+        }
+        if (argv[arg][0] >= '0' && argv[arg][0] <= '9')
+        {
+            seconds = atoi(argv[arg]);
+            continue;
+        }
+        while (b < NUM_BENCHES && strcmp(argv[arg], benches[b].name) != 0)
+            b++;
+        if (b == NUM_BENCHES)
+        {
+            usage();
+            return 2;
+        }
+        selected[b] = any = true;
+    }
+
+    // the golden CRCs are for a fixed length and all benches
+    if (checkFile || goldenFile)
+    {
+        seconds = CHECK_SECONDS;
+        any = false;
+    }
+    for (int b = 0; b < NUM_BENCHES; b++)
+        selected[b] = selected[b] || !any;
+
+    size_t frames = (size_t) (seconds > 0 ? seconds : 1) * BENCH_FS;
+
+    printf("%d s per signal, %d channels, %d Hz, blocks of %d frames\n",
+           seconds, BENCH_CHANS, BENCH_FS, BENCH_BLOCK);
+
+    for (int kind = 0; kind < NUM_SIGNALS; kind++)
+    {
+        generate(kind, sig, frames);
+        for (int b = 0; b < NUM_BENCHES; b++)
+            if (selected[b] && benches[b].perSignal)
+                benches[b].perSignal(kind, sig, frames);
+    }
+
+    for (int b = 0; b < NUM_BENCHES; b++)
+        if (selected[b] && benches[b].once)
+            benches[b].once();
+
+    int errors = failedTests;
+
+    if (goldenFile)
+        errors += writeResults(goldenFile);
+    if (checkFile)
+        errors += checkResults(checkFile);
+    if (checkFile || failedTests)
+        printf("%s: %lu CRCs, %d failed tests, %d errors\n", errors ? "FAILED" : "passed",
+               (unsigned long) results.size(), failedTests, errors - failedTests);
+
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,269 @@
+/*---------------------------------------------------------------------------*\
+|   Uniformly Partitioned FFT Convolution (host only)                         |
+\*---------------------------------------------------------------------------*/
+
+#include <math.h>
+#include <string.h>
+#include "fft_convolver.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+RealFFT::RealFFT(int n)
+    : n(n), m(n / 2), bitrev(n / 2), cosTab(n / 2), sinTab(n / 2), zr(n / 2), zi(n / 2)
+{
+    int bits = 0;
+
+    while ((1 << bits) < m)
+        bits++;
+
+    for (int i=0; i<m; i++)
+    {
+        int r = 0;
+        for (int b=0; b<bits; b++)
+            r |= ((i >> b) & 1) << (bits - 1 - b);
+        bitrev[i] = r;
+    }
+
+    for (int k=0; k<n/2; k++)
+    {
+        cosTab[k] = (float) cos(2 * M_PI * k / n);
+        sinTab[k] = (float) -sin(2 * M_PI * k / n);
+    }
+}
+
+// in place, forward, input in natural order
+void RealFFT::complexFFT(float *re, float *im)
+{
+    for (int i=0; i<m; i++)
+    {
+        int r = bitrev[i];
+        if (r > i)
+        {
+            float t = re[i]; re[i] = re[r]; re[r] = t;
+            t = im[i]; im[i] = im[r]; im[r] = t;
+        }
+    }
+
+    int L = 1;
+
+    // one radix-2 stage if log2(m) is odd
+    if (((31 - __builtin_clz((unsigned) m)) & 1) != 0)
+    {
+        for (int i=0; i<m; i+=2)
+        {
+            float ar = re[i], ai = im[i];
+            float br = re[i+1], bi = im[i+1];
+            re[i] = ar + br; im[i] = ai + bi;
+            re[i+1] = ar - br; im[i+1] = ai - bi;
+        }
+        L = 2;
+    }
+
+    // radix-4: two radix-2 stages (2L and 4L) per pass over the data
+    for (; L < m; L *= 4)
+    {
+        int s2 = n / (2 * L);                   // twiddle stride of W_2L
+        int s4 = n / (4 * L);                   // twiddle stride of W_4L
+
+        for (int base=0; base<m; base+=4*L)
+            for (int j=0; j<L; j++)
+            {
+                int i0 = base + j, i1 = i0 + L, i2 = i1 + L, i3 = i2 + L;
+                float w2r = cosTab[j * s2], w2i = sinTab[j * s2];
+                float w4r = cosTab[j * s4], w4i = sinTab[j * s4];
+                float tr, ti;
+
+                // stage 2L: (i0, i1) and (i2, i3) with W_2L^j
+                tr = w2r * re[i1] - w2i * im[i1];
+                ti = w2r * im[i1] + w2i * re[i1];
+                float a0r = re[i0] + tr, a0i = im[i0] + ti;
+                float a1r = re[i0] - tr, a1i = im[i0] - ti;
+
+                tr = w2r * re[i3] - w2i * im[i3];
+                ti = w2r * im[i3] + w2i * re[i3];
+                float b0r = re[i2] + tr, b0i = im[i2] + ti;
+                float b1r = re[i2] - tr, b1i = im[i2] - ti;
+
+                // stage 4L: (a0, b0) with W_4L^j, (a1, b1) with -j W_4L^j
+                tr = w4r * b0r - w4i * b0i;
+                ti = w4r * b0i + w4i * b0r;
+                re[i0] = a0r + tr; im[i0] = a0i + ti;
+                re[i2] = a0r - tr; im[i2] = a0i - ti;
+
+                tr = w4r * b1i + w4i * b1r;
+                ti = -(w4r * b1r - w4i * b1i);
+                re[i1] = a1r + tr; im[i1] = a1i + ti;
+                re[i3] = a1r - tr; im[i3] = a1i - ti;
+            }
+    }
+}
+
+void RealFFT::forward(const float *x, float *re, float *im)
+{
+    // even samples real, odd samples imaginary
+    for (int i=0; i<m; i++)
+    {
+        zr[i] = x[2*i];
+        zi[i] = x[2*i + 1];
+    }
+    complexFFT(&zr[0], &zi[0]);
+
+    re[0] = zr[0] + zi[0];
+    im[0] = 0;
+    re[m] = zr[0] - zi[0];
+    im[m] = 0;
+
+    for (int k=1; k<m; k++)
+    {
+        // even part E = (Z[k] + Z*[m-k]) / 2, odd part O = (Z[k] - Z*[m-k]) / 2j
+        float er = 0.5f * (zr[k] + zr[m-k]), ei = 0.5f * (zi[k] - zi[m-k]);
+        float or_ = 0.5f * (zi[k] + zi[m-k]), oi = -0.5f * (zr[k] - zr[m-k]);
+
+        re[k] = er + cosTab[k] * or_ - sinTab[k] * oi;
+        im[k] = ei + cosTab[k] * oi + sinTab[k] * or_;
+    }
+}
+
+void RealFFT::inverse(const float *re, const float *im, float *x)
+{
+    for (int k=0; k<m; k++)
+    {
+        // E = (X[k] + X*[m-k]) / 2, O = (X[k] - X*[m-k]) / 2 * W^-k
+        float er = 0.5f * (re[k] + re[m-k]), ei = 0.5f * (im[k] - im[m-k]);
+        float dr = 0.5f * (re[k] - re[m-k]), di = 0.5f * (im[k] + im[m-k]);
+        float or_ = dr * cosTab[k] + di * sinTab[k];
+        float oi = di * cosTab[k] - dr * sinTab[k];
+
+        // Z = E + jO, inverse by conjugation around the forward FFT
+        zr[k] = er - oi;
+        zi[k] = -(ei + or_);
+    }
+    complexFFT(&zr[0], &zi[0]);
+
+    for (int i=0; i<m; i++)
+    {
+        x[2*i] = zr[i];
+        x[2*i + 1] = -zi[i];
+    }
+}
+
+FFTConvolver::FFTConvolver(int partition, const float *h, size_t taps)
+    : B(partition), P((int) ((taps + partition - 1) / partition)), bins(partition + 1),
+      fdlPos(0), fft(2 * partition)
+{
+    std::vector<float> seg(2 * B);
+
+    if (P < 1)
+        P = 1;
+
+    hRe.resize(P * bins);
+    hIm.resize(P * bins);
+    xRe.resize(P * bins);
+    xIm.resize(P * bins);
+    accRe.resize(bins);
+    accIm.resize(bins);
+    window.resize(2 * B);
+    time.resize(2 * B);
+
+    // partition spectra, scaled by 1/B for the unnormalised inverse
+    for (int p=0; p<P; p++)
+    {
+        for (int i=0; i<2*B; i++)
+        {
+            size_t k = (size_t) p * B + i;
+            seg[i] = i < B && k < taps ? h[k] / B : 0.f;
+        }
+        fft.forward(&seg[0], &hRe[p * bins], &hIm[p * bins]);
+    }
+
+    reset();
+}
+
+void FFTConvolver::reset(void)
+{
+    memset(&xRe[0], 0, xRe.size() * sizeof(float));
+    memset(&xIm[0], 0, xIm.size() * sizeof(float));
+    memset(&window[0], 0, window.size() * sizeof(float));
+    fdlPos = 0;
+}
+
+void FFTConvolver::process(const float *in, float *out)
+{
+    // slide the input window by one partition
+    memmove(&window[0], &window[B], B * sizeof(float));
+    memcpy(&window[B], in, B * sizeof(float));
+
+    fdlPos = fdlPos + 1 < P ? fdlPos + 1 : 0;
+    fft.forward(&window[0], &xRe[fdlPos * bins], &xIm[fdlPos * bins]);
+
+    // Y = sum over p of X(now - p) H(p)
+    memset(&accRe[0], 0, bins * sizeof(float));
+    memset(&accIm[0], 0, bins * sizeof(float));
+
+    for (int p=0, x=fdlPos; p<P; p++, x = x > 0 ? x - 1 : P - 1)
+    {
+        const float *hr = &hRe[p * bins], *hi = &hIm[p * bins];
+        const float *xr = &xRe[x * bins], *xi = &xIm[x * bins];
+        float *ar = &accRe[0], *ai = &accIm[0];
+
+        for (int k=0; k<bins; k++)
+        {
+            ar[k] += xr[k] * hr[k] - xi[k] * hi[k];
+            ai[k] += xr[k] * hi[k] + xi[k] * hr[k];
+        }
+    }
+
+    // the second half is free of circular wrap-around
+    fft.inverse(&accRe[0], &accIm[0], &time[0]);
+    memcpy(out, &time[B], B * sizeof(float));
+}
+
+FFTConvolverNode::FFTConvolverNode(int channels, int partition, const float *h,
+                                   size_t taps, int irChannels)
+    : numChans(channels), B(partition), fill(0),
+      inBuf(channels * partition), outBuf(channels * partition)
+{
+    for (int c=0; c<numChans; c++)
+        conv.push_back(new FFTConvolver(partition, h + (irChannels > 1 ? c * taps : 0), taps));
+}
+
+FFTConvolverNode::~FFTConvolverNode(void)
+{
+    for (size_t c=0; c<conv.size(); c++)
+        delete conv[c];
+}
+
+void FFTConvolverNode::reset(void)
+{
+    for (int c=0; c<numChans; c++)
+        conv[c]->reset();
+    memset(&inBuf[0], 0, inBuf.size() * sizeof(float));
+    memset(&outBuf[0], 0, outBuf.size() * sizeof(float));
+    fill = 0;
+}
+
+void FFTConvolverNode::processBlock(int32_t *const in[], int32_t *out, size_t frames)
+{
+    const int32_t *src = in[0];
+
+    for (size_t n=0; n<frames; n++, src+=numChans, out+=numChans)
+    {
+        for (int c=0; c<numChans; c++)
+        {
+            float y = outBuf[c * B + fill];
+
+            inBuf[c * B + fill] = (float) src[c];
+            out[c] = y >= 2147483647.f ? 0x7FFFFFFF :
+                     y <= -2147483648.f ? (int32_t) 0x80000000 : (int32_t) lrintf(y);
+        }
+
+        if (++fill == B)
+        {
+            for (int c=0; c<numChans; c++)
+                conv[c]->process(&inBuf[c * B], &outBuf[c * B]);
+            fill = 0;
+        }
+    }
+}
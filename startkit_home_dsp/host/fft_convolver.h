@@ -0,0 +1,113 @@
+/*---------------------------------------------------------------------------*\
+|   Uniformly Partitioned FFT Convolution (host only)                         |
+|                                                                             |
+|   Overlap-save convolution for long FIR filters, e.g. room correction       |
+|   impulse responses of up to a few seconds. The filter is cut into          |
+|   partitions of B taps; each block of B new samples costs one real FFT of   |
+|   size 2B, one complex multiply-add per partition and bin over the          |
+|   frequency-domain delay line, and one inverse FFT. The latency is B        |
+|   samples, so B trades latency against throughput.                          |
+|                                                                             |
+|   RealFFT is a single precision radix-4 FFT (plus one radix-2 stage for     |
+|   odd powers of two) of N/2 complex points with the real-input split, no    |
+|   external library. FFTConvolverNode runs one convolver per channel as a    |
+|   DspNode, see cppdsp_set_external_node().                                  |
+\*---------------------------------------------------------------------------*/
+
+#ifndef FFT_CONVOLVER_H
+#define FFT_CONVOLVER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include "dsp_graph.h"
+
+class RealFFT
+{
+public:
+    // n: power of two, at least 4
+    explicit RealFFT(int n);
+
+    // x[n] -> bins 0..n/2 of the DFT (e^-j)
+    void forward(const float *x, float *re, float *im);
+
+    // bins 0..n/2 -> x[n], scaled by n/2 (not normalised)
+    void inverse(const float *re, const float *im, float *x);
+
+    int size(void) const
+    {
+        return n;
+    }
+
+private:
+    int n;                                      // real points
+    int m;                                      // complex points, n/2
+    std::vector<int> bitrev;                    // of m
+    std::vector<float> cosTab, sinTab;          // e^-j2pi k/n, k < n/2
+    std::vector<float> zr, zi;                  // complex work buffer
+
+    void complexFFT(float *re, float *im);
+};
+
+class FFTConvolver
+{
+public:
+    // partition size B (power of two >= 2), h[taps]
+    FFTConvolver(int partition, const float *h, size_t taps);
+
+    // B new input samples -> the B output samples of the same block
+    void process(const float *in, float *out);
+
+    void reset(void);
+
+    int partitionSize(void) const
+    {
+        return B;
+    }
+
+    int partitions(void) const
+    {
+        return P;
+    }
+
+private:
+    int B;                                      // partition size
+    int P;                                      // number of partitions
+    int bins;                                   // B + 1
+    int fdlPos;                                 // newest spectrum
+    RealFFT fft;
+    std::vector<float> hRe, hIm;                // P x bins
+    std::vector<float> xRe, xIm;                // delay line, P x bins
+    std::vector<float> accRe, accIm;
+    std::vector<float> window;                  // last 2B input samples
+    std::vector<float> time;
+};
+
+// one FFTConvolver per channel on interleaved int32 blocks of any length;
+// adds a latency of one partition
+class FFTConvolverNode : public DspNode
+{
+public:
+    // h: taps per channel, channel-major (h[c * taps + k]); with
+    // irChannels = 1 all channels use the same filter
+    FFTConvolverNode(int channels, int partition, const float *h, size_t taps,
+                     int irChannels);
+    ~FFTConvolverNode(void);
+
+    void processBlock(int32_t *const in[], int32_t *out, size_t frames);
+    void reset(void);
+
+    int latency(void) const
+    {
+        return B;
+    }
+
+private:
+    int numChans;
+    int B;
+    int fill;                                   // frames in the current partition
+    std::vector<FFTConvolver *> conv;
+    std::vector<float> inBuf, outBuf;           // channel-major, B each
+};
+
+#endif  // FFT_CONVOLVER_H
@@ -0,0 +1,84 @@
+/*---------------------------------------------------------------------------*\
+|   Generator for the EQ32 design tables                                      |
+|                                                                             |
+|   Writes eq32_tables.cpp for the grids defined in eq32_tables.h.            |
+|                                                                             |
+|   Build and run (from this directory):                                      |
+|       g++ -O2 -I../src -o gen_eq32_tables gen_eq32_tables.cpp               |
+|       ./gen_eq32_tables > ../src/eq32_tables.cpp                            |
+\*---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <math.h>
+#include "eq32_tables.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+static int32_t toFixed(double x, int bits)
+{
+    return (int32_t) floor(ldexp(x, bits) + 0.5);
+}
+
+static void printRow(const int32_t *row, int cols, bool last, const char *comment)
+{
+    printf("    {");
+    for (int i = 0; i < cols; i++)
+        printf("%s%11ld", i ? ", " : " ", (long) row[i]);
+    printf(" }%s  // %s\n", last ? " " : ",", comment);
+}
+
+int main(void)
+{
+    char comment[64];
+    int32_t row[4];
+
+    printf("/*---------------------------------------------------------------------------*\\\n"
+           "|   EQ32 design tables, generated by host/gen_eq32_tables.cpp - do not edit   |\n"
+           "\\*---------------------------------------------------------------------------*/\n\n"
+           "#include \"eq32_tables.h\"\n\n");
+
+    printf("const int32_t eq32FreqTable[EQ32_FREQ_STEPS][EQ32_FREQ_COLS] = {\n");
+    for (int k = 0; k < EQ32_FREQ_STEPS; k++)
+    {
+        double f = 0.5 * pow(2., (double) (k - (EQ32_FREQ_STEPS - 1)) / EQ32_FREQ_STEPS_PER_OCTAVE);
+        double omega = 2. * M_PI * f;
+
+        row[EQ32_FREQ_NORM] = toFixed(f, EQ32_FREQ_BITS);
+        row[EQ32_FREQ_COS] = toFixed(cos(omega), EQ32_FREQ_BITS);
+        row[EQ32_FREQ_SIN] = toFixed(sin(omega), EQ32_FREQ_BITS);
+        snprintf(comment, sizeof(comment), "%8.1f Hz at 48 kHz", f * 48000.);
+        printRow(row, EQ32_FREQ_COLS, k == EQ32_FREQ_STEPS - 1, comment);
+    }
+    printf("};\n\n");
+
+    printf("const int32_t eq32GainTable[EQ32_GAIN_STEPS][EQ32_GAIN_COLS] = {\n");
+    for (int k = 0; k < EQ32_GAIN_STEPS; k++)
+    {
+        double gain = EQ32_GAIN_MIN_DB + (double) k / EQ32_GAIN_STEPS_PER_DB;
+        double A = pow(10., gain / 40.);
+
+        row[EQ32_GAIN_A] = toFixed(A, EQ32_GAIN_BITS);
+        row[EQ32_GAIN_SQRT_A] = toFixed(sqrt(A), EQ32_GAIN_BITS);
+        snprintf(comment, sizeof(comment), "%+5.1f dB", gain);
+        printRow(row, EQ32_GAIN_COLS, k == EQ32_GAIN_STEPS - 1, comment);
+    }
+    printf("};\n\n");
+
+    printf("const int32_t eq32QTable[EQ32_Q_STEPS][EQ32_Q_COLS] = {\n");
+    for (int k = 0; k < EQ32_Q_STEPS; k++)
+    {
+        double Q = EQ32_Q_MIN * pow(2., (double) k / EQ32_Q_STEPS_PER_OCTAVE);
+        double S = Q < 1 ? Q : 1;
+
+        row[EQ32_Q_VALUE] = toFixed(Q, EQ32_Q_BITS);
+        row[EQ32_Q_SINH] = toFixed(sinh(1. / (2 * Q)), EQ32_Q_BITS);
+        row[EQ32_Q_INV_S] = toFixed(1. / S, EQ32_Q_BITS);
+        snprintf(comment, sizeof(comment), "Q %6.3f", Q);
+        printRow(row, EQ32_Q_COLS, k == EQ32_Q_STEPS - 1, comment);
+    }
+    printf("};\n");
+
+    return 0;
+}
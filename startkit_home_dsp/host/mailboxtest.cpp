@@ -0,0 +1,139 @@
+/*---------------------------------------------------------------------------*\
+|   Host stress test of the parameter mailbox                                 |
+|                                                                             |
+|   A producer thread publishes settings as fast as it can while a consumer   |
+|   thread fetches them in a tight loop, as the control and DSP tasks do      |
+|   with ParamMailbox. Every published struct has all words set to its        |
+|   sequence number plus a checksum, so a copy that mixes two updates is      |
+|   detected. It checks that every fetched struct is internally consistent    |
+|   and that the sequence numbers only grow, and prints the fetches, the      |
+|   dropped races and the failures. Exit code 1 on a failure.                 |
+|                                                                             |
+|   The copy yields halfway on about half of the fetches, so that the         |
+|   producer runs in the middle of it even on a host with a single core. An   |
+|   x86 host keeps stores in order, so this mostly catches the compiler       |
+|   moving the slot writes across the sequence number; the weaker ordering of |
+|   other hosts is covered by MAILBOX_BARRIER().                              |
+|                                                                             |
+|   Build (from this directory): make mailboxtest, or                         |
+|       g++ -O3 -std=c++11 -pthread -I../src -o mailboxtest mailboxtest.cpp   |
+|                                                                             |
+|   Usage:                                                                    |
+|       mailboxtest [seconds]                                                 |
+\*---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "param_mailbox.h"
+
+// about the size of the cppdsp ChainSettings
+#define TEST_WORDS 40
+
+static volatile uint32_t spin;
+
+// the copy in fetch() gives the core away halfway, so that the producer
+// can overwrite the slot in the middle of it even on a single core host
+struct Settings
+{
+    uint32_t words[TEST_WORDS];
+    uint32_t check;
+
+    Settings &operator=(const Settings &other)
+    {
+        for (int i = 0; i < TEST_WORDS; i++)
+        {
+            if (i == TEST_WORDS / 2 && (spin & 1))
+                std::this_thread::yield();
+            words[i] = other.words[i];
+        }
+        check = other.check;
+        return *this;
+    }
+};
+
+static ParamMailbox<Settings> mailbox;
+static std::atomic<bool> done(false);
+
+static uint32_t checksum(const Settings &set)
+{
+    uint32_t sum = 0x5A5A5A5A;
+
+    for (int i = 0; i < TEST_WORDS; i++)
+        sum = (sum << 5 | sum >> 27) ^ set.words[i];
+    return sum;
+}
+
+// random pause of up to a few hundred ns, so that fetches land before,
+// during and after the writes of an update; every 16th update gives the
+// core away, for hosts with fewer cores than threads
+static void pause(uint32_t &seed)
+{
+    seed = seed * 1664525u + 1013904223u;
+    for (uint32_t k = seed >> 24; k > 0; k--)
+        spin++;
+    if ((seed >> 20 & 15) == 0)
+        std::this_thread::yield();
+}
+
+static void producer(uint32_t *published)
+{
+    uint32_t n = 0, seed = 1;
+
+    while (!done)
+    {
+        pause(seed);
+
+        Settings &set = mailbox.beginWrite();
+
+        n++;
+        for (int i = 0; i < TEST_WORDS; i++)
+            set.words[i] = n;
+        set.check = checksum(set);
+        mailbox.publish();
+    }
+    *published = n;
+}
+
+int main(int argc, char *argv[])
+{
+    double seconds = argc > 1 ? atof(argv[1]) : 2.0;
+    unsigned long fetched = 0, empty = 0, torn = 0, backwards = 0;
+    uint32_t published = 0, last = 0;
+    Settings set;
+
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now() +
+        std::chrono::microseconds((long long) (seconds * 1e6));
+    std::thread prod(producer, &published);
+
+    while (std::chrono::steady_clock::now() < end)
+        for (int k = 0; k < 1000; k++)
+        {
+            if (!mailbox.fetch(set))
+            {
+                empty++;
+                std::this_thread::yield();
+                continue;
+            }
+
+            bool same = set.check == checksum(set);
+            for (int i = 1; i < TEST_WORDS; i++)
+                same = same && set.words[i] == set.words[0];
+
+            torn += !same;
+            backwards += set.words[0] <= last;
+            last = set.words[0];
+            fetched++;
+        }
+
+    done = true;
+    prod.join();
+
+    printf("%u published, %lu fetched, %lu empty or raced, %lu inconsistent, "
+           "%lu out of order  %s\n", published, fetched, empty, torn, backwards,
+           torn || backwards || fetched == 0 ? "FAILED" : "ok");
+
+    return torn || backwards || fetched == 0 ? 1 : 0;
+}
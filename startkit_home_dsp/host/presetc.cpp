@@ -0,0 +1,276 @@
+/*---------------------------------------------------------------------------*\
+|   Preset compiler for the cppdsp chain                                      |
+|                                                                             |
+|   Turns a text preset into the binary format of src/dsp_preset.h. Filter    |
+|   coefficients are designed here, so the device only copies them. The       |
+|   result is loaded back through cppdsp_load_preset() to check it and to     |
+|   measure the apply latency.                                                |
+|                                                                             |
+|   Build (from this directory):                                              |
+|       g++ -O3 -std=c++11 -I../src -o presetc presetc.cpp ../src/eq32.cpp    |
+|           ../src/eq32_tables.cpp ../src/limiter32.cpp ../src/fixmath.cpp    |
+|           ../src/cppdsp.cpp ../src/dsp_preset.cpp ../src/dynamics32.cpp     |
+|           ../src/dsp_load.c                                                 |
+|                                                                             |
+|   Usage:                                                                    |
+|       presetc in.txt out.bin                                                |
+|                                                                             |
+|   Text format, one item per line, '#' starts a comment:                     |
+|       name    <text>                                                        |
+|       stage   <index> <type> <f0 Hz> <gain dB> <Q>                          |
+|       active  <number of stages>                                            |
+|       input   <gain> <shift>        gain factor 0..2, times 2^shift,        |
+|                                     shift -31..30                           |
+|       output  <gain> <shift>                                                |
+|       limiter <threshold dB> <lookahead s> <hold s> <release s>             |
+|   Types: GAIN LOW_PASS HIGH_PASS BAND_PASS NOTCH PEAKING LOW_SHELF          |
+|          HIGH_SHELF LOW_SHELFQ HIGH_SHELFQ ALLPASS                          |
+\*---------------------------------------------------------------------------*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "cppdsp.h"
+#include "dsp_load.h"
+#include "dsp_preset.h"
+#include "dsp_nodes.h"
+#include "limiter32.h"
+
+static const char *typeNames[] = {
+    "GAIN", "LOW_PASS", "HIGH_PASS", "BAND_PASS", "NOTCH", "PEAKING",
+    "LOW_SHELF", "HIGH_SHELF", "LOW_SHELFQ", "HIGH_SHELFQ", "ALLPASS"
+};
+
+#define NUM_TYPES (int) (sizeof(typeNames) / sizeof(typeNames[0]))
+
+class PresetWriter
+{
+public:
+    PresetWriter(void)
+    {
+        put(DSP_PRESET_MAGIC);
+        put(DSP_PRESET_VERSION);
+        put(0);                             // size, patched in finish()
+    }
+
+    void record(uint32_t tag, const int32_t *payload, uint32_t words)
+    {
+        put(tag | (words << 16));
+        for (uint32_t i=0; i<words; i++)
+            put((uint32_t) payload[i]);
+    }
+
+    const std::vector<uint8_t> &finish(void)
+    {
+        size_t size = bytes.size() + 4;
+        for (int i=0; i<4; i++)
+            bytes[8 + i] = (uint8_t) (size >> (8 * i));
+        put(dspPresetCrc32(&bytes[0], bytes.size()));
+        return bytes;
+    }
+
+private:
+    void put(uint32_t w)
+    {
+        for (int i=0; i<4; i++)
+            bytes.push_back((uint8_t) (w >> (8 * i)));
+    }
+
+    std::vector<uint8_t> bytes;
+};
+
+static int32_t toQ24(double x)
+{
+    return (int32_t) lround(x * (1 << 24));
+}
+
+static int parseType(const char *name)
+{
+    for (int t=0; t<NUM_TYPES; t++)
+        if (strcmp(name, typeNames[t]) == 0)
+            return t;
+    return -1;
+}
+
+static bool compileLine(char *line, PresetWriter &out)
+{
+    char *hash = strchr(line, '#');
+    if (hash)
+        *hash = 0;
+
+    char key[16];
+    int used = 0;
+    if (sscanf(line, " %15s %n", key, &used) != 1)
+        return true;                        // empty line
+    const char *args = line + used;
+
+    if (strcmp(key, "name") == 0)
+    {
+        int32_t text[DSP_PRESET_NAME_LEN / 4] = {0};
+        size_t len = strcspn(args, "\r\n");
+        if (len > DSP_PRESET_NAME_LEN)
+            len = DSP_PRESET_NAME_LEN;
+        memcpy(text, args, len);
+        out.record(DSP_PRESET_NAME, text, (uint32_t) (len + 3) / 4);
+        return true;
+    }
+
+    if (strcmp(key, "stage") == 0)
+    {
+        char type[16];
+        int index, t;
+        double f0, gain, Q;
+        if (sscanf(args, "%d %15s %lf %lf %lf", &index, type, &f0, &gain, &Q) != 5 ||
+            index < 0 || index >= DSP_PRESET_MAX_STAGES || (t = parseType(type)) < 0)
+            return false;
+
+        EQ32Base eq(t, f0, SAMPLE_FREQUENCY, gain, Q);
+        int32_t rec[DSP_PRESET_EQ_STAGE_WORDS] = {
+            index, t, (int32_t) lround(f0 * 100), toQ24(gain), toQ24(Q)
+        };
+        eq.getNewCoefficients(&rec[5]);
+        out.record(DSP_PRESET_EQ_STAGE, rec, DSP_PRESET_EQ_STAGE_WORDS);
+        return true;
+    }
+
+    if (strcmp(key, "active") == 0)
+    {
+        int32_t n;
+        if (sscanf(args, "%d", &n) != 1 || n < 0 || n > DSP_PRESET_MAX_STAGES)
+            return false;
+        out.record(DSP_PRESET_EQ_ACTIVE, &n, 1);
+        return true;
+    }
+
+    if (strcmp(key, "input") == 0 || strcmp(key, "output") == 0)
+    {
+        double gain;
+        int shift;
+        if (sscanf(args, "%lf %d", &gain, &shift) != 2 || gain < 0 || gain >= 2.0 ||
+            shift < DSP_SHIFT_MIN || shift > DSP_SHIFT_MAX)
+            return false;
+        int32_t rec[DSP_PRESET_GAIN_WORDS] = {
+            key[0] == 'i' ? DSP_PRESET_INPUT : DSP_PRESET_OUTPUT,
+            (int32_t) lround(gain * (1 << 30)), shift
+        };
+        out.record(DSP_PRESET_GAIN, rec, DSP_PRESET_GAIN_WORDS);
+        return true;
+    }
+
+    if (strcmp(key, "limiter") == 0)
+    {
+        double thr, tAtt, tHold, tRel;
+        if (sscanf(args, "%lf %lf %lf %lf", &thr, &tAtt, &tHold, &tRel) != 4)
+            return false;
+        Limiter32Base lim(thr, tAtt, tHold, tRel, SAMPLE_FREQUENCY);
+        int32_t rec[DSP_PRESET_LIMITER_WORDS];
+        lim.getFixedParams(rec[0], rec[1], rec[2], rec[3]);
+        out.record(DSP_PRESET_LIMITER, rec, DSP_PRESET_LIMITER_WORDS);
+        return true;
+    }
+
+    return false;
+}
+
+// load + publish on the control side, then the first block on the DSP
+// side that takes the new settings, against a block without a switch
+static void measureApply(const std::vector<uint8_t> &bin)
+{
+    const int runs = 10000;
+    int32_t block[DSP_BLOCK_FRAMES * NUM_CHANS] = {0};
+    dsp_load_stats_t load, apply, steady;
+
+    dsp_load_reset(&load, 0);
+    dsp_load_reset(&apply, 0);
+    dsp_load_reset(&steady, 0);
+    cppdsp_process_block(block, DSP_BLOCK_FRAMES);
+
+    for (int r=0; r<runs; r++)
+    {
+        uint32_t t0 = dsp_load_host_ticks();
+        cppdsp_load_preset(&bin[0], bin.size());
+        uint32_t t1 = dsp_load_host_ticks();
+        cppdsp_process_block(block, DSP_BLOCK_FRAMES);
+        uint32_t t2 = dsp_load_host_ticks();
+        cppdsp_process_block(block, DSP_BLOCK_FRAMES);
+        uint32_t t3 = dsp_load_host_ticks();
+
+        dsp_load_update(&load, t1 - t0);
+        dsp_load_update(&apply, t2 - t1);
+        dsp_load_update(&steady, t3 - t2);
+    }
+
+    printf("load + publish: mean %u ns, max %u ns\n",
+           dsp_load_mean(&load), load.max_ticks);
+    printf("switching block: mean %u ns (%d ns over a plain block of %u ns)\n",
+           dsp_load_mean(&apply),
+           (int) dsp_load_mean(&apply) - (int) dsp_load_mean(&steady),
+           dsp_load_mean(&steady));
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc != 3)
+    {
+        fprintf(stderr, "usage: presetc in.txt out.bin\n");
+        return 1;
+    }
+
+    FILE *in = fopen(argv[1], "r");
+    if (!in)
+    {
+        fprintf(stderr, "presetc: cannot read %s\n", argv[1]);
+        return 1;
+    }
+
+    cppdsp_init_eq();
+
+    PresetWriter writer;
+    char line[256];
+    int lineNo = 0;
+
+    while (fgets(line, sizeof(line), in))
+    {
+        lineNo++;
+        if (!compileLine(line, writer))
+        {
+            fprintf(stderr, "presetc: %s:%d: cannot parse '%s'\n", argv[1], lineNo,
+                    strtok(line, "\r\n"));
+            fclose(in);
+            return 1;
+        }
+    }
+    fclose(in);
+
+    const std::vector<uint8_t> &bin = writer.finish();
+    if (bin.size() > DSP_PRESET_MAX_BYTES)
+    {
+        fprintf(stderr, "presetc: preset has %lu bytes, at most %d fit\n",
+                (unsigned long) bin.size(), DSP_PRESET_MAX_BYTES);
+        return 1;
+    }
+
+    int err = cppdsp_load_preset(&bin[0], bin.size());
+    if (err != DSP_PRESET_OK)
+    {
+        fprintf(stderr, "presetc: the chain rejects the preset (error %d)\n", err);
+        return 1;
+    }
+
+    FILE *out = fopen(argv[2], "wb");
+    if (!out || fwrite(&bin[0], 1, bin.size(), out) != bin.size())
+    {
+        fprintf(stderr, "presetc: cannot write %s\n", argv[2]);
+        if (out)
+            fclose(out);
+        return 1;
+    }
+    fclose(out);
+
+    printf("%s: %lu bytes\n", argv[2], (unsigned long) bin.size());
+    measureApply(bin);
+
+    return 0;
+}
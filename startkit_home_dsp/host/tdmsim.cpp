@@ -0,0 +1,152 @@
+/*---------------------------------------------------------------------------*\
+|   Host model of the TDM output mode                                         |
+|                                                                             |
+|   Runs a stereo WAV file through the same path as the startKIT with         |
+|   TDM_OUTPUT=1: the codec input is fanned out to NUM_CHANS channels,        |
+|   cppdsp_process_block() processes all of them per block and the result     |
+|   is placed on the TDM slots. The output file has one channel per TDM       |
+|   slot. Prints the slot map and the throughput of the multichannel chain.   |
+|                                                                             |
+|   Build (from this directory):                                              |
+|       g++ -O3 -std=c++11 -DTDM_OUTPUT=1 -I../src -o tdmsim tdmsim.cpp       |
+|           wav_file.cpp ../src/tdm_slot_map.c ../src/eq32.cpp                |
+|           ../src/eq32_tables.cpp ../src/limiter32.cpp ../src/fixmath.cpp    |
+|           ../src/cppdsp.cpp ../src/dsp_preset.cpp ../src/dynamics32.cpp     |
+|           ../src/dsp_load.c                                                 |
+|                                                                             |
+|   Usage:                                                                    |
+|       tdmsim [-b frames] in.wav out.wav                                     |
+\*---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "cppdsp.h"
+#include "dsp_load.h"
+#include "tdm_slot_map.h"
+#include "wav_file.h"
+
+#if !TDM_OUTPUT
+#error "build tdmsim with -DTDM_OUTPUT=1"
+#endif
+
+static void usage(void)
+{
+    fprintf(stderr, "usage: tdmsim [-b frames] in.wav out.wav\n"
+                    "  -b frames  block size (default %d)\n", DSP_BLOCK_FRAMES);
+}
+
+static void printSlotMap(void)
+{
+    printf("slot:   ");
+    for (int s=0; s<TDM_CHANS_PER_FRAME; s++)
+        printf("%3d", s);
+    printf("\nchannel:");
+    for (int s=0; s<TDM_CHANS_PER_FRAME; s++)
+        if (tdm_slot_map[s] == TDM_SLOT_UNUSED)
+            printf("  -");
+        else
+            printf("%3d", tdm_slot_map[s]);
+    printf("\ninput:  ");
+    for (int s=0; s<TDM_CHANS_PER_FRAME; s++)
+        if (tdm_slot_map[s] == TDM_SLOT_UNUSED)
+            printf("  -");
+        else
+            printf("%3c", tdm_input_map[tdm_slot_map[s]] ? 'R' : 'L');
+    printf("\n");
+}
+
+int main(int argc, char *argv[])
+{
+    size_t blockFrames = DSP_BLOCK_FRAMES;
+    int arg = 1;
+
+    while (arg < argc && argv[arg][0] == '-')
+    {
+        if (strcmp(argv[arg], "-b") == 0 && arg + 1 < argc)
+        {
+            blockFrames = (size_t) atoi(argv[arg + 1]);
+            arg += 2;
+        }
+        else
+        {
+            usage();
+            return 1;
+        }
+    }
+
+    if (argc - arg != 2 || blockFrames < 1)
+    {
+        usage();
+        return 1;
+    }
+
+    WavReader in;
+    WavWriter out;
+
+    if (!in.open(argv[arg]))
+    {
+        fprintf(stderr, "tdmsim: cannot read %s\n", argv[arg]);
+        return 1;
+    }
+
+    if (in.channels() != CODEC_CHANS)
+    {
+        fprintf(stderr, "tdmsim: %s has %d channels, the codec delivers %d\n",
+                argv[arg], in.channels(), CODEC_CHANS);
+        return 1;
+    }
+
+    int outBits = in.isFloat() ? 32 : in.bitsPerSample();
+    if (!out.open(argv[arg + 1], TDM_CHANS_PER_FRAME, in.sampleRate(), outBits))
+    {
+        fprintf(stderr, "tdmsim: cannot write %s\n", argv[arg + 1]);
+        return 1;
+    }
+
+    std::vector<int32_t> codec(blockFrames * CODEC_CHANS);
+    std::vector<int32_t> block(blockFrames * NUM_CHANS);
+    std::vector<int32_t> slots(blockFrames * TDM_CHANS_PER_FRAME);
+    dsp_load_stats_t stats;
+    size_t frames, total = 0;
+
+    cppdsp_init_eq();
+    dsp_load_reset(&stats, (uint32_t) (1e9 * blockFrames / in.sampleRate()));
+
+    while ((frames = in.read(&codec[0], blockFrames)) > 0)
+    {
+        for (size_t n=0; n<frames; n++)
+            tdm_fan_in(&codec[n * CODEC_CHANS], &block[n * NUM_CHANS]);
+
+        uint32_t start = dsp_load_host_ticks();
+        cppdsp_process_block(&block[0], frames);
+        dsp_load_update(&stats, dsp_load_host_ticks() - start);
+
+        for (size_t n=0; n<frames; n++)
+            tdm_fill_slots(&block[n * NUM_CHANS], &slots[n * TDM_CHANS_PER_FRAME]);
+
+        if (!out.write(&slots[0], frames))
+        {
+            fprintf(stderr, "tdmsim: write error on %s\n", argv[arg + 1]);
+            return 1;
+        }
+        total += frames;
+    }
+
+    out.close();
+
+    double seconds = stats.sum_ticks * 1e-9;
+    double rate = seconds > 0 ? total / seconds : 0;
+
+    printSlotMap();
+    printf("%lu frames of %d channels in %lu blocks of %lu\n", (unsigned long) total,
+           NUM_CHANS, (unsigned long) stats.passes, (unsigned long) blockFrames);
+    printf("block time: min %u ns, mean %u ns, max %u ns (deadline %u ns, %u over)\n",
+           stats.min_ticks, dsp_load_mean(&stats), stats.max_ticks,
+           stats.deadline_ticks, stats.deadline_misses);
+    printf("throughput: %.0f frames/s, %.1f ns/channel-sample, %.1f x realtime\n", rate,
+           rate > 0 ? 1e9 / (rate * NUM_CHANS) : 0, rate / in.sampleRate());
+
+    return 0;
+}
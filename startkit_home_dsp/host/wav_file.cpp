@@ -0,0 +1,234 @@
+/*---------------------------------------------------------------------------*\
+|   Minimal streaming WAV file reader / writer for the host tools             |
+\*---------------------------------------------------------------------------*/
+
+#include <string.h>
+#include "wav_file.h"
+
+#define WAVE_FORMAT_PCM         0x0001
+#define WAVE_FORMAT_IEEE_FLOAT  0x0003
+#define WAVE_FORMAT_EXTENSIBLE  0xFFFE
+
+static uint32_t getLE(const uint8_t *p, int bytes)
+{
+    uint32_t v = 0;
+    for (int i = bytes - 1; i >= 0; i--)
+        v = (v << 8) | p[i];
+    return v;
+}
+
+static void putLE(uint8_t *p, uint32_t v, int bytes)
+{
+    for (int i = 0; i < bytes; i++, v >>= 8)
+        p[i] = (uint8_t) v;
+}
+
+WavReader::WavReader(void)
+{
+    file = NULL;
+    nChans = 0;
+    fs = 0;
+    bits = 0;
+    floatFormat = false;
+    nFrames = 0;
+    framesLeft = 0;
+}
+
+WavReader::~WavReader(void)
+{
+    close();
+}
+
+bool WavReader::open(const char *path)
+{
+    uint8_t hdr[12], chunk[8], fmt[40];
+    bool haveFmt = false;
+
+    close();
+    file = fopen(path, "rb");
+    if (!file)
+        return false;
+
+    if (fread(hdr, 1, 12, file) != 12 ||
+        memcmp(hdr, "RIFF", 4) != 0 || memcmp(hdr + 8, "WAVE", 4) != 0)
+    {
+        close();
+        return false;
+    }
+
+    while (fread(chunk, 1, 8, file) == 8)
+    {
+        uint32_t size = getLE(chunk + 4, 4);
+
+        if (memcmp(chunk, "fmt ", 4) == 0)
+        {
+            uint32_t n = size < sizeof(fmt) ? size : sizeof(fmt);
+            if (n < 16 || fread(fmt, 1, n, file) != n)
+                break;
+            if (fseek(file, (long)(size - n + (size & 1)), SEEK_CUR) != 0)
+                break;
+
+            int format = getLE(fmt, 2);
+            nChans = getLE(fmt + 2, 2);
+            fs = getLE(fmt + 4, 4);
+            bits = getLE(fmt + 14, 2);
+            if (format == WAVE_FORMAT_EXTENSIBLE && n >= 26)
+                format = getLE(fmt + 24, 2);
+
+            floatFormat = (format == WAVE_FORMAT_IEEE_FLOAT);
+            if ((format != WAVE_FORMAT_PCM && !floatFormat) ||
+                (floatFormat && bits != 32) ||
+                (!floatFormat && bits != 16 && bits != 24 && bits != 32) ||
+                nChans < 1)
+                break;
+            haveFmt = true;
+        }
+        else if (memcmp(chunk, "data", 4) == 0)
+        {
+            if (!haveFmt)
+                break;
+            nFrames = size / (nChans * (bits / 8));
+            framesLeft = nFrames;
+            return true;
+        }
+        else if (fseek(file, (long)(size + (size & 1)), SEEK_CUR) != 0)
+            break;
+    }
+
+    close();
+    return false;
+}
+
+void WavReader::close(void)
+{
+    if (file)
+        fclose(file);
+    file = NULL;
+}
+
+size_t WavReader::read(int32_t *interleaved, size_t frames)
+{
+    const int bytes = bits / 8;
+    uint8_t buf[4];
+
+    if (frames > framesLeft)
+        frames = framesLeft;
+
+    for (size_t n = 0; n < frames * nChans; n++)
+    {
+        if (fread(buf, 1, bytes, file) != (size_t) bytes)
+        {
+            framesLeft = 0;
+            return n / nChans;
+        }
+
+        if (floatFormat)
+        {
+            float f;
+            uint32_t u = getLE(buf, 4);
+            memcpy(&f, &u, 4);
+            double d = f * 2147483648.0;
+            if (d > 2147483647.0)
+                d = 2147483647.0;
+            if (d < -2147483648.0)
+                d = -2147483648.0;
+            interleaved[n] = (int32_t) d;
+        }
+        else
+        {
+            interleaved[n] = (int32_t) (getLE(buf, bytes) << (32 - bits));
+        }
+    }
+
+    framesLeft -= frames;
+    return frames;
+}
+
+WavWriter::WavWriter(void)
+{
+    file = NULL;
+    nChans = 0;
+    bits = 0;
+    dataBytes = 0;
+}
+
+WavWriter::~WavWriter(void)
+{
+    close();
+}
+
+bool WavWriter::open(const char *path, int channels, int sampleRate, int bitsPerSample)
+{
+    uint8_t hdr[44];
+
+    close();
+    if (bitsPerSample != 16 && bitsPerSample != 24 && bitsPerSample != 32)
+        return false;
+
+    file = fopen(path, "wb");
+    if (!file)
+        return false;
+
+    nChans = channels;
+    bits = bitsPerSample;
+    dataBytes = 0;
+
+    // sizes are patched in close()
+    memcpy(hdr, "RIFF", 4);
+    putLE(hdr + 4, 36, 4);
+    memcpy(hdr + 8, "WAVEfmt ", 8);
+    putLE(hdr + 16, 16, 4);
+    putLE(hdr + 20, WAVE_FORMAT_PCM, 2);
+    putLE(hdr + 22, channels, 2);
+    putLE(hdr + 24, sampleRate, 4);
+    putLE(hdr + 28, sampleRate * channels * (bits / 8), 4);
+    putLE(hdr + 32, channels * (bits / 8), 2);
+    putLE(hdr + 34, bits, 2);
+    memcpy(hdr + 36, "data", 4);
+    putLE(hdr + 40, 0, 4);
+
+    if (fwrite(hdr, 1, sizeof(hdr), file) != sizeof(hdr))
+    {
+        fclose(file);
+        file = NULL;
+        return false;
+    }
+    return true;
+}
+
+void WavWriter::close(void)
+{
+    uint8_t size[4];
+
+    if (!file)
+        return;
+
+    if (dataBytes & 1)
+        fputc(0, file);
+
+    putLE(size, 36 + dataBytes + (dataBytes & 1), 4);
+    fseek(file, 4, SEEK_SET);
+    fwrite(size, 1, 4, file);
+    putLE(size, dataBytes, 4);
+    fseek(file, 40, SEEK_SET);
+    fwrite(size, 1, 4, file);
+
+    fclose(file);
+    file = NULL;
+}
+
+bool WavWriter::write(const int32_t *interleaved, size_t frames)
+{
+    const int bytes = bits / 8;
+    uint8_t buf[4];
+
+    for (size_t n = 0; n < frames * nChans; n++)
+    {
+        putLE(buf, (uint32_t) interleaved[n] >> (32 - bits), bytes);
+        if (fwrite(buf, 1, bytes, file) != (size_t) bytes)
+            return false;
+    }
+
+    dataBytes += (uint32_t) (frames * nChans * bytes);
+    return true;
+}
@@ -0,0 +1,61 @@
+/*---------------------------------------------------------------------------*\
+|   Minimal streaming WAV file reader / writer for the host tools             |
+|                                                                             |
+|   Reads PCM 16/24/32 bit and IEEE float 32 bit (also in                     |
+|   WAVE_FORMAT_EXTENSIBLE files), samples are converted to left-justified    |
+|   int32_t as used by the DSP on the startKIT.                               |
+\*---------------------------------------------------------------------------*/
+
+#ifndef WAV_FILE_H
+#define WAV_FILE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+class WavReader
+{
+public:
+    WavReader(void);
+    ~WavReader(void);
+    bool open(const char *path);
+    void close(void);
+
+    // reads up to frames interleaved frames, returns frames read
+    size_t read(int32_t *interleaved, size_t frames);
+
+    int channels(void) const { return nChans; }
+    int sampleRate(void) const { return fs; }
+    int bitsPerSample(void) const { return bits; }
+    bool isFloat(void) const { return floatFormat; }
+    size_t frames(void) const { return nFrames; }
+
+private:
+    FILE *file;
+    int nChans;
+    int fs;
+    int bits;
+    bool floatFormat;
+    size_t nFrames;
+    size_t framesLeft;
+};
+
+class WavWriter
+{
+public:
+    WavWriter(void);
+    ~WavWriter(void);
+    bool open(const char *path, int channels, int sampleRate, int bitsPerSample);
+    void close(void);
+
+    // writes frames interleaved frames, returns false on error
+    bool write(const int32_t *interleaved, size_t frames);
+
+private:
+    FILE *file;
+    int nChans;
+    int bits;
+    uint32_t dataBytes;
+};
+
+#endif  // WAV_FILE_H
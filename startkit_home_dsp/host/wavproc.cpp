@@ -0,0 +1,234 @@
+/*---------------------------------------------------------------------------*\
+|   Offline WAV processor for the cppdsp chain                                |
+|                                                                             |
+|   Streams a WAV file of any length through cppdsp_process_block() in       |
+|   fixed-size blocks, writes the result and reports the throughput.         |
+|                                                                             |
+|   Build (from this directory):                                              |
+|       g++ -O3 -std=c++11 -I../src -o wavproc wavproc.cpp wav_file.cpp       |
+|           fft_convolver.cpp ../src/eq32.cpp ../src/eq32_tables.cpp          |
+|           ../src/limiter32.cpp ../src/fixmath.cpp ../src/cppdsp.cpp         |
+|           ../src/dsp_preset.cpp ../src/dynamics32.cpp ../src/dsp_load.c     |
+|   Add -DMULTIBAND_DYNAMICS=1 to run the chain with the 3 band compressor.   |
+|                                                                             |
+|   -c adds a long FIR filter (e.g. room correction) from a WAV file, one     |
+|   channel for all or one per chain channel, as FFTConvolverNode before the  |
+|   limiter. -P sets its partition size and with it the added latency.        |
+|                                                                             |
+|   Usage:                                                                    |
+|       wavproc [-b frames] [-p preset.bin] [-c ir.wav [-P partition]]        |
+|               in.wav out.wav                                                |
+\*---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "cppdsp.h"
+#include "dsp_load.h"
+#include "dsp_preset.h"
+#include "fft_convolver.h"
+#include "wav_file.h"
+
+#define CONV_PARTITION 256
+
+static void usage(void)
+{
+    fprintf(stderr, "usage: wavproc [-b frames] [-p preset.bin] [-c ir.wav [-P partition]]\n"
+                    "               in.wav out.wav\n"
+                    "  -b frames  block size (default %d)\n"
+                    "  -p file    binary preset from presetc\n"
+                    "  -c file    impulse response for the FFT convolver\n"
+                    "  -P frames  convolver partition size, power of two (default %d)\n",
+                    DSP_BLOCK_FRAMES, CONV_PARTITION);
+}
+
+static bool loadPreset(const char *name)
+{
+    uint8_t data[DSP_PRESET_MAX_BYTES];
+    FILE *f = fopen(name, "rb");
+
+    if (!f)
+    {
+        fprintf(stderr, "wavproc: cannot read %s\n", name);
+        return false;
+    }
+    size_t size = fread(data, 1, sizeof(data), f);
+    fclose(f);
+
+    int err = cppdsp_load_preset(data, size);
+    if (err != DSP_PRESET_OK)
+    {
+        fprintf(stderr, "wavproc: %s is not a valid preset (error %d)\n", name, err);
+        return false;
+    }
+    return true;
+}
+
+// impulse response as float, channel-major; 0 on error
+static FFTConvolverNode *loadConvolver(const char *name, int partition)
+{
+    WavReader ir;
+
+    if (!ir.open(name))
+    {
+        fprintf(stderr, "wavproc: cannot read %s\n", name);
+        return 0;
+    }
+    if (ir.channels() != 1 && ir.channels() != NUM_CHANS)
+    {
+        fprintf(stderr, "wavproc: %s has %d channels, expected 1 or %d\n",
+                name, ir.channels(), NUM_CHANS);
+        return 0;
+    }
+    if (ir.sampleRate() != SAMPLE_FREQUENCY)
+        fprintf(stderr, "wavproc: warning: %s is %d Hz, the chain is designed for %d Hz\n",
+                name, ir.sampleRate(), SAMPLE_FREQUENCY);
+
+    int chans = ir.channels();
+    size_t taps = ir.frames();
+    std::vector<int32_t> raw(taps * chans);
+    std::vector<float> h(taps * chans);
+
+    taps = ir.read(&raw[0], taps);
+    if (taps == 0)
+    {
+        fprintf(stderr, "wavproc: %s is empty\n", name);
+        return 0;
+    }
+    for (size_t k=0; k<taps; k++)
+        for (int c=0; c<chans; c++)
+            h[c * taps + k] = raw[k * chans + c] * (1.f / 2147483648.f);
+
+    printf("convolver: %lu taps x %d, partition %d, latency %d frames\n",
+           (unsigned long) taps, chans, partition, partition);
+    return new FFTConvolverNode(NUM_CHANS, partition, &h[0], taps, chans);
+}
+
+int main(int argc, char *argv[])
+{
+    size_t blockFrames = DSP_BLOCK_FRAMES;
+    const char *presetFile = 0;
+    const char *irFile = 0;
+    int partition = CONV_PARTITION;
+    int arg = 1;
+
+    while (arg < argc && argv[arg][0] == '-')
+    {
+        if (strcmp(argv[arg], "-b") == 0 && arg + 1 < argc)
+        {
+            blockFrames = (size_t) atoi(argv[arg + 1]);
+            arg += 2;
+        }
+        else if (strcmp(argv[arg], "-p") == 0 && arg + 1 < argc)
+        {
+            presetFile = argv[arg + 1];
+            arg += 2;
+        }
+        else if (strcmp(argv[arg], "-c") == 0 && arg + 1 < argc)
+        {
+            irFile = argv[arg + 1];
+            arg += 2;
+        }
+        else if (strcmp(argv[arg], "-P") == 0 && arg + 1 < argc)
+        {
+            partition = atoi(argv[arg + 1]);
+            arg += 2;
+        }
+        else
+        {
+            usage();
+            return 1;
+        }
+    }
+
+    if (argc - arg != 2 || blockFrames < 1 || partition < 2 || (partition & (partition - 1)))
+    {
+        usage();
+        return 1;
+    }
+
+    uint32_t initStart = dsp_load_host_ticks();
+    cppdsp_init_eq();
+    uint32_t initTicks = dsp_load_host_ticks() - initStart;
+
+    if (presetFile && !loadPreset(presetFile))
+        return 1;
+
+    FFTConvolverNode *convolver = 0;
+    if (irFile)
+    {
+        if (!(convolver = loadConvolver(irFile, partition)))
+            return 1;
+        cppdsp_set_external_node(convolver);
+    }
+
+    WavReader in;
+    WavWriter out;
+
+    if (!in.open(argv[arg]))
+    {
+        fprintf(stderr, "wavproc: cannot read %s\n", argv[arg]);
+        return 1;
+    }
+
+    if (in.channels() != NUM_CHANS)
+    {
+        fprintf(stderr, "wavproc: %s has %d channels, the chain expects %d\n",
+                argv[arg], in.channels(), NUM_CHANS);
+        return 1;
+    }
+
+    if (in.sampleRate() != SAMPLE_FREQUENCY)
+        fprintf(stderr, "wavproc: warning: %s is %d Hz, the chain is designed for %d Hz\n",
+                argv[arg], in.sampleRate(), SAMPLE_FREQUENCY);
+
+    int outBits = in.isFloat() ? 32 : in.bitsPerSample();
+    if (!out.open(argv[arg + 1], NUM_CHANS, in.sampleRate(), outBits))
+    {
+        fprintf(stderr, "wavproc: cannot write %s\n", argv[arg + 1]);
+        return 1;
+    }
+
+    std::vector<int32_t> block(blockFrames * NUM_CHANS);
+    dsp_load_stats_t stats;
+    size_t frames, total = 0;
+
+    // deadline of a block in ns at the file's sample rate
+    dsp_load_reset(&stats, (uint32_t) (1e9 * blockFrames / in.sampleRate()));
+
+    while ((frames = in.read(&block[0], blockFrames)) > 0)
+    {
+        uint32_t start = dsp_load_host_ticks();
+        cppdsp_process_block(&block[0], frames);
+        dsp_load_update(&stats, dsp_load_host_ticks() - start);
+
+        if (!out.write(&block[0], frames))
+        {
+            fprintf(stderr, "wavproc: write error on %s\n", argv[arg + 1]);
+            return 1;
+        }
+        total += frames;
+    }
+
+    out.close();
+
+    double seconds = stats.sum_ticks * 1e-9;
+    double rate = seconds > 0 ? total / seconds : 0;
+
+    printf("init: %u ns\n", initTicks);
+    printf("%lu frames in %lu blocks of %lu\n", (unsigned long) total,
+           (unsigned long) stats.passes, (unsigned long) blockFrames);
+    printf("block time: min %u ns, mean %u ns, max %u ns (deadline %u ns, %u over)\n",
+           stats.min_ticks, dsp_load_mean(&stats), stats.max_ticks,
+           stats.deadline_ticks, stats.deadline_misses);
+    printf("throughput: %.0f frames/s, %.1f x realtime\n", rate,
+           rate / in.sampleRate());
+
+    if (convolver)
+    {
+        cppdsp_set_external_node(0);
+        delete convolver;
+    }
+    return 0;
+}
@@ -0,0 +1,335 @@
+/*---------------------------------------------------------------------------*\
+|   Fused Fixed-Point Biquad Cascade                                          |
+|                                                                             |
+|   All stage coefficients and states live in one contiguous, stage-major     |
+|   array. Every stage of a sample is run in one loop, so the intermediate    |
+|   signal stays in a register instead of being written back between stages. |
+|   Coefficients are designed with EQ32 and share its fixed-point format.     |
+|   Each stage is classified when its coefficients are taken over (see        |
+|   classifyBiquad()); bypassed stages are left out of the run list and cost  |
+|   nothing per sample, gain and first-order stages use shorter kernels.      |
+|   A stage that joins the run list again (no longer flat, or activated)      |
+|   takes the current history of its input signal from its neighbours, see   |
+|   seedStage(), so it does not restart from samples of long ago.             |
+|   setRampLength() moves changed stages to their new coefficients in linear  |
+|   steps per block instead of one jump (see clampBiquadFeedback()).          |
+\*---------------------------------------------------------------------------*/
+
+#ifndef BIQUAD_CASCADE_H
+#define BIQUAD_CASCADE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "eq32.h"
+
+// design parameters of one cascade stage (see EQ32)
+struct BiquadParams
+{
+    int    type;                            // filter type
+    double f0;                              // center/corner frequency (Hz)
+    double gain;                            // gain (dB)
+    double Q;                               // quality factor
+};
+
+template <int NumStages, int NumChans, bool ErrorFeedback = (ERROR_FEEDBACK != 0)>
+class BiquadCascade
+{
+protected:
+    struct Stage
+    {
+        int32_t coefficients[BIQUAD_COEFFS];        // { b0, b1, b2, -a1, -a2 }
+        int     kind;                               // kernel for coefficients
+        int32_t states[NumChans][BIQUAD_STATES];    // filter states
+    };
+
+    bool    update_filter;                          // flag for coefficient update
+    int     numActive;                              // stages run by process
+    int     numRun;                                 // active, not bypassed
+    int     run[NumStages];                         // indices of those stages
+    int32_t lastIn[NumChans][2];                    // input history, no stage run
+    int32_t rampLength;                             // coefficient ramp (samples)
+    int32_t rampRemaining;                          // samples left in the ramp
+    int32_t rampStep[NumStages][BIQUAD_COEFFS];     // coefficient change per sample
+    int32_t newCoefficients[NumStages][BIQUAD_COEFFS];
+    Stage   stages[NumStages];
+
+    // one-shot, classification happens here and not per sample
+    void takeCoefficients(void)
+    {
+        for (int s=0; s<NumStages; s++)
+        {
+            for (int i=0; i<BIQUAD_COEFFS; i++)
+                stages[s].coefficients[i] = newCoefficients[s][i];
+            stages[s].kind = classifyBiquad(stages[s].coefficients);
+        }
+        update_filter = false;
+        rampRemaining = 0;
+        updateRunList();
+    }
+
+    // changed stages run the full kernel until the ramp has ended
+    void startRamp(void)
+    {
+        for (int s=0; s<NumStages; s++)
+        {
+            int32_t *c = stages[s].coefficients;
+
+            startBiquadRamp(c, newCoefficients[s], rampLength, rampStep[s]);
+            for (int i=0; i<BIQUAD_COEFFS; i++)
+                if (c[i] != newCoefficients[s][i])
+                    stages[s].kind = BIQUAD_FULL;
+        }
+        update_filter = false;
+        rampRemaining = rampLength;
+        updateRunList();
+    }
+
+    void stepRamp(int32_t frames)
+    {
+        if (frames >= rampRemaining)
+        {
+            takeCoefficients();
+            return;
+        }
+
+        for (int s=0; s<NumStages; s++)
+            stepBiquadRamp(stages[s].coefficients, rampStep[s], frames);
+        rampRemaining -= frames;
+    }
+
+    // called once per block before the coefficients are read
+    inline void updateCoefficients(size_t frames)
+    {
+        if (expected_false(update_filter))
+        {
+            if (rampLength > 0)
+                startRamp();
+            else
+                takeCoefficients();
+        }
+
+        if (expected_false(rampRemaining > 0))
+            stepRamp((int32_t) frames);
+    }
+
+    void updateRunList(void)
+    {
+        bool wasRun[NumStages];
+
+        for (int s=0; s<NumStages; s++)
+            wasRun[s] = false;
+        for (int r=0; r<numRun; r++)
+            wasRun[run[r]] = true;
+
+        numRun = 0;
+        for (int s=0; s<numActive; s++)
+            if (stages[s].kind != BIQUAD_BYPASS)
+            {
+                if (!wasRun[s])
+                    seedStage(s, wasRun);
+                run[numRun++] = s;
+            }
+    }
+
+    // Stages that were not run pass the signal on unchanged, so the input
+    // of stage s is the output of the closest stage before it that was
+    // run, or the input of the closest one after it, or the cascade input
+    // if none was run. The stage takes that history for x and y, as if
+    // it had been a bypass on the full kernel; the error state is kept.
+    void seedStage(int s, const bool wasRun[])
+    {
+        int before = s - 1, after = s + 1;
+
+        while (before >= 0 && !wasRun[before])
+            before--;
+        while (after < NumStages && !wasRun[after])
+            after++;
+
+        for (int c=0; c<NumChans; c++)
+        {
+            int32_t *st = stages[s].states[c];
+            int32_t x1, x2;
+
+            if (before >= 0)
+            {
+                x1 = stages[before].states[c][2];
+                x2 = stages[before].states[c][3];
+            }
+            else if (after < NumStages)
+            {
+                x1 = stages[after].states[c][0];
+                x2 = stages[after].states[c][1];
+            }
+            else
+            {
+                x1 = lastIn[c][0];
+                x2 = lastIn[c][1];
+            }
+            st[0] = x1;
+            st[1] = x2;
+            st[2] = x1;
+            st[3] = x2;
+        }
+    }
+
+    // runs all active stages on one sample of one channel
+    inline int32_t processSample(int32_t x, int chan)
+    {
+        for (int r=0; r<numRun; r++)
+        {
+            Stage *st = &stages[run[r]];
+
+            x = biquadSample<ErrorFeedback>(st->coefficients, st->states[chan], x, st->kind);
+        }
+        return x;
+    }
+
+    // while no stage is run the cascade is a copy, the input history is
+    // kept for the stage that is run first
+    void keepInput(const int32_t *interleaved, size_t frames)
+    {
+        if (frames == 0)
+            return;
+
+        const int32_t *last = interleaved + (frames - 1) * NumChans;
+
+        for (int c=0; c<NumChans; c++)
+        {
+            lastIn[c][1] = frames > 1 ? last[c - NumChans] : lastIn[c][0];
+            lastIn[c][0] = last[c];
+        }
+    }
+
+    // no stage run yet, all states 0
+    void init(void)
+    {
+        numActive = NumStages;
+        numRun = 0;
+        rampLength = 0;
+        rampRemaining = 0;
+        update_filter = false;
+        resetStates();
+    }
+
+public:
+    BiquadCascade(void)
+    {
+        init();
+        for (int s=0; s<NumStages; s++)
+        {
+            newCoefficients[s][0] = fixed_one;
+            for (int i=1; i<BIQUAD_COEFFS; i++)
+                newCoefficients[s][i] = 0;
+        }
+        takeCoefficients();
+    }
+
+    BiquadCascade(const BiquadParams params[NumStages], double fs)
+    {
+        init();
+        for (int s=0; s<NumStages; s++)
+            designStage(s, params[s].type, params[s].f0, fs,
+                        params[s].gain, params[s].Q);
+        takeCoefficients();
+    }
+
+    void designStage(int stage, int type, double f0, double fs, double gain, double Q)
+    {
+        int32_t coeffs[BIQUAD_COEFFS];
+        EQ32 eq(type, f0, fs, gain, Q);
+
+        eq.getNewCoefficients(coeffs);
+        setStageCoefficients(stage, coeffs);
+    }
+
+    void setStageCoefficients(int stage, const int32_t coeffs[BIQUAD_COEFFS])
+    {
+        if (stage < 0 || stage >= NumStages)
+            return;
+
+        for (int i=0; i<BIQUAD_COEFFS; i++)
+            newCoefficients[stage][i] = coeffs[i];
+        update_filter = true;
+    }
+
+    // 0 switches coefficients in one step, otherwise changed stages are
+    // moved linearly over the given number of samples (in block steps)
+    void setRampLength(int32_t samples)
+    {
+        if (samples < 0)
+            samples = 0;
+
+        rampLength = samples;
+    }
+
+    // only the first n stages are run; stages that are activated again
+    // continue from the current signal (see seedStage())
+    void setActiveStages(int n)
+    {
+        if (n < 0)
+            n = 0;
+
+        if (n > NumStages)
+            n = NumStages;
+
+        numActive = n;
+        updateRunList();
+    }
+
+    int getActiveStages(void) const
+    {
+        return numActive;
+    }
+
+    // active stages that are not bypassed, as of the last update
+    int getRunStages(void) const
+    {
+        return numRun;
+    }
+
+    // pending coefficients and a running ramp are taken over at once,
+    // there is no signal to smooth after a reset
+    void resetStates(void)
+    {
+        if (update_filter || rampRemaining > 0)
+            takeCoefficients();
+
+        for (int s=0; s<NumStages; s++)
+            for (int c=0; c<NumChans; c++)
+                for (int j=0; j<BIQUAD_STATES; j++)
+                    stages[s].states[c][j] = 0;
+
+        for (int c=0; c<NumChans; c++)
+            lastIn[c][0] = lastIn[c][1] = 0;
+    }
+
+    inline void process(int32_t samples[])
+    {
+        updateCoefficients(1);
+
+        if (expected_false(numRun == 0))
+            keepInput(samples, 1);
+
+        for (int c=0; c<NumChans; c++)
+            samples[c] = processSample(samples[c], c);
+    }
+
+    // interleaved block: samples[frame * NumChans + channel]
+    inline void processBlock(int32_t *interleaved, size_t frames)
+    {
+        // pending coefficients and ramps advance at the block boundary only
+        updateCoefficients(frames);
+
+        if (expected_false(numRun == 0))
+        {
+            keepInput(interleaved, frames);
+            return;
+        }
+
+        for (size_t n=0; n<frames; n++, interleaved+=NumChans)
+            for (int c=0; c<NumChans; c++)
+                interleaved[c] = processSample(interleaved[c], c);
+    }
+};
+
+#endif  // BIQUAD_CASCADE_H
@@ -6,36 +6,312 @@
  */
 
 #include "cppdsp.h"
-#include "eq32.h"
-#include "limiter32.h"
+#include "dsp_graph.h"
+#include "dsp_nodes.h"
+#include "dsp_preset.h"
+#include "param_mailbox.h"
 
-static EQ32 pEQ1(PEAKING_EQ, 55.0, SAMPLE_FREQUENCY, 11.0, 1.0);
-static EQ32 pEQ2(PEAKING_EQ, 55.0, SAMPLE_FREQUENCY, 11.0, 1.0);
-static EQ32 hiPass1(HIGH_PASS_EQ, 40, SAMPLE_FREQUENCY, 0.0, 0.85);
-static EQ32 hiPass2(HIGH_PASS_EQ, 40, SAMPLE_FREQUENCY, 0.0, 0.85);
-static EQ32 hiShelv(HIGH_SHELF_EQ, 8000, SAMPLE_FREQUENCY, 3.0, 0.71);
+#define EQ_STAGES 5
 
-static Limiter32 postprocLim(-30.2, 0.001, 0.1, 1.0, NUM_CHANS, SAMPLE_FREQUENCY);
+//EQ changes are ramped over this many frames, 0 switches in one step
+#ifndef EQ_RAMP_FRAMES
+#define EQ_RAMP_FRAMES 256
+#endif
+
+// 1: 3 band compressor between EQ and limiter, e.g. for PA use
+#ifndef MULTIBAND_DYNAMICS
+#define MULTIBAND_DYNAMICS 0
+#endif
+
+//Default EQ: type, f0 (Hz), gain (0.01 dB), Q (0.001), designed with
+//designEQInt(), no floating point math with EQ32_FIXED_DESIGN
+static const struct {
+    int type;
+    int32_t f0Hz, gainCdB, qMilli;
+} eqParams[EQ_STAGES] = {
+    {PEAKING_EQ,    55,   1100, 1000},      // bass boost
+    {PEAKING_EQ,    55,   1100, 1000},      // bass boost
+    {HIGH_PASS_EQ,  40,   0,    850 },      // subsonic filter
+    {HIGH_PASS_EQ,  40,   0,    850 },      // subsonic filter
+    {HIGH_SHELF_EQ, 8000, 300,  710 }       // treble
+};
+
+//Limiter defaults: threshold (dB), lookahead, hold, release (s)
+#define LIM_THRESHOLD   -30.2
+#define LIM_ATTACK      0.001
+#define LIM_HOLD        0.1
+#define LIM_RELEASE     1.0
+
+//Processing nodes, all storage is static. The constructors only set
+//neutral defaults, the chain is designed by cppdsp_init_eq()
+static GainNode<NUM_CHANS> inputGain;
+static BiquadNode<EQ_STAGES, NUM_CHANS> eqChain;
+static LimiterNode<NUM_CHANS, SAMPLE_FREQUENCY/1000> postprocLim;
+static GainNode<NUM_CHANS> outputGain;
+
+#if TDM_OUTPUT
+//Stereo input split into woofer, low mid, high mid and tweeter bands
+#define XOVER_BANDS (NUM_CHANS / CODEC_CHANS)
+static const double xoverFreqs[XOVER_BANDS - 1] = {120.0, 1200.0, 5000.0};
+static CrossoverNode<CODEC_CHANS, XOVER_BANDS> crossover;
+#endif
+
+#if MULTIBAND_DYNAMICS
+//Band splits (Hz) and per band threshold (dB), ratio, knee (dB), attack, release (s)
+static const double mbFreqs[2] = {150.0, 2500.0};
+static const double mbParams[3][5] = {
+    {-40.0, 3.0, 6.0, 0.020, 0.250},    // low
+    {-40.0, 3.0, 6.0, 0.010, 0.150},    // mid
+    {-40.0, 3.0, 6.0, 0.005, 0.100}     // high
+};
+static MultibandNode<NUM_CHANS, 3> multiband;
+#endif
+
+#define GRAPH_MAX_NODES 8
+
+static DspGraph<GRAPH_MAX_NODES, 0, NUM_CHANS, DSP_BLOCK_FRAMES> graph;
+static bool initDone = false;
+
+//Optional node of the host tools, see cppdsp_set_external_node()
+static DspNode *externalNode = 0;
+
+// all runtime settings of the chain, handed from the control task to the DSP
+struct ChainSettings {
+    int32_t coeffs[EQ_STAGES][BIQUAD_COEFFS];
+    int32_t activeStages;
+    int32_t gain[DSP_PRESET_GAINS];
+    int32_t shift[DSP_PRESET_GAINS];
+    int32_t limThreshold;
+    int32_t limLookahead;
+    int32_t limHold;
+    int32_t limRelease;
+};
+
+static ParamMailbox<ChainSettings> chainMailbox;
+
+// producer side copy, only touched by the control task
+static ChainSettings chainControlSet;
+static bool chainControlSetValid = false;
+
+// design table positions of the default bands, control task as well
+static int32_t eqFreqPos[EQ_STAGES];
+static int32_t eqQPos[EQ_STAGES];
+
+//Default chain: gain staging, EQ, limiter at -30.2dBFS, make-up gain,
+//all in place on the audio block. TDM_OUTPUT splits the stereo input
+//into the band channels first, MULTIBAND_DYNAMICS compresses 3 bands
+//before the limiter; an external node of the host tools runs right
+//before the limiter
+static void buildGraph() {
+
+    graph.clear();
+    graph.addNode(inputGain, 0, 0);
+#if TDM_OUTPUT
+    graph.addNode(crossover, 0, 0);
+#endif
+    graph.addNode(eqChain, 0, 0);
+#if MULTIBAND_DYNAMICS
+    graph.addNode(multiband, 0, 0);
+#endif
+    if (externalNode) {
+        graph.addNode(*externalNode, 0, 0);
+    }
+    graph.addNode(postprocLim, 0, 0);
+    graph.addNode(outputGain, 0, 0);
+    graph.compile();
+}
+
+//Runs on the DSP task between two blocks
+static void applyChainSettings(const ChainSettings &set) {
+
+    for (int s = 0; s < EQ_STAGES; ++s) {
+        eqChain.setStageCoefficients(s, set.coeffs[s]);
+    }
+    eqChain.setActiveStages(set.activeStages);
+    inputGain.setGain(set.gain[DSP_PRESET_INPUT], set.shift[DSP_PRESET_INPUT]);
+    outputGain.setGain(set.gain[DSP_PRESET_OUTPUT], set.shift[DSP_PRESET_OUTPUT]);
+    postprocLim.setFixedParams(set.limThreshold, set.limLookahead, set.limHold, set.limRelease);
+}
 
 void cppdsp_process_eq(int32_t inSamps[NUM_CHANS]) {
+    cppdsp_process_block(inSamps, 1);
+}
+
+void cppdsp_process_block(int32_t samples[], size_t frames) {
+
+    ChainSettings update;
+
+    //cppdsp_init_eq() builds the producer side settings as well, so it
+    //never runs from here; the audio passes unchanged until it was called
+    if (!initDone) {
+        return;
+    }
+
+    //Take new settings from the control task, if any
+    if (chainMailbox.fetch(update)) {
+        applyChainSettings(update);
+    }
+
+    graph.process(samples, frames);
+}
 
-    for (int i = 0; i < NUM_CHANS; ++i) {
-        //Damp by ~24dBFS
-        inSamps[i] >>= 4;
+static void initChainControlSet() {
+
+    if (chainControlSetValid) {
+        return;
+    }
+
+    for (int s = 0; s < EQ_STAGES; ++s) {
+        EQ32Base eq;
+        eq.designEQInt(eqParams[s].type, eqParams[s].f0Hz, SAMPLE_FREQUENCY,
+                       eqParams[s].gainCdB, eqParams[s].qMilli);
+        eq.getNewCoefficients(chainControlSet.coeffs[s]);
+        eqFreqPos[s] = eq32FreqPos(eqParams[s].f0Hz, SAMPLE_FREQUENCY);
+        eqQPos[s] = eq32QPos(eqParams[s].qMilli);
     }
+    chainControlSet.activeStages = EQ_STAGES;
+    chainControlSet.gain[DSP_PRESET_INPUT] = DSP_GAIN_ONE;
+    chainControlSet.shift[DSP_PRESET_INPUT] = -4;                       // damp by ~24dB
+    chainControlSet.gain[DSP_PRESET_OUTPUT] = DSP_GAIN_ONE;
+    chainControlSet.shift[DSP_PRESET_OUTPUT] = 5;                       // amplify by ~30.1dB
+
+    Limiter32Base lim(LIM_THRESHOLD, LIM_ATTACK, LIM_HOLD, LIM_RELEASE, SAMPLE_FREQUENCY);
+    lim.getFixedParams(chainControlSet.limThreshold, chainControlSet.limLookahead,
+                       chainControlSet.limHold, chainControlSet.limRelease);
+
+    chainControlSetValid = true;
+}
+
+static void publishChainControlSet() {
+    chainMailbox.beginWrite() = chainControlSet;
+    chainMailbox.publish();
+}
 
-    //Equalizer processing
-    pEQ1.process(inSamps);
-    pEQ2.process(inSamps);
-    hiPass1.process(inSamps);
-    hiPass2.process(inSamps);
-    hiShelv.process(inSamps);
+void cppdsp_init_eq() {
 
-    //Postprocess Limiter to force signal amplitudes below -30.2dBFS after EQing
-    postprocLim.process(inSamps);
+    ChainSettings stale;
+
+    //Design the default settings, drop updates published before
+    chainControlSetValid = false;
+    initChainControlSet();
+    while (chainMailbox.fetch(stale)) {
+    }
 
-    //Amplify by ~30.1dB
-    for (int i = 0; i < NUM_CHANS; ++i) {
-        inSamps[i] <<= 5;
+    //The graph reset takes the defaults over at once, later changes ramp
+    eqChain.setRampLength(EQ_RAMP_FRAMES);
+    applyChainSettings(chainControlSet);
+#if TDM_OUTPUT
+    crossover.design(LR4, xoverFreqs, SAMPLE_FREQUENCY);
+#endif
+#if MULTIBAND_DYNAMICS
+    multiband.design(mbFreqs, SAMPLE_FREQUENCY);
+    for (int k = 0; k < 3; ++k) {
+        multiband.band(k).setCompressor(mbParams[k][0], mbParams[k][1], mbParams[k][2]);
+        multiband.band(k).setTimes(mbParams[k][3], mbParams[k][4], SAMPLE_FREQUENCY);
     }
+#endif
+    buildGraph();
+    graph.reset();
+
+    initDone = true;
+}
+
+void cppdsp_set_external_node(DspNode *node) {
+
+    //Before cppdsp_init_eq() the node is only stored, init builds the graph
+    externalNode = node;
+    if (initDone) {
+        buildGraph();
+        graph.reset();
+    }
+}
+
+void cppdsp_set_eq_band(unsigned band, int type, double f0, double gain, double Q) {
+
+    if (band >= EQ_STAGES) {
+        return;
+    }
+
+    initChainControlSet();
+
+    //Coefficient design runs here, off the audio path
+    EQ32Base eq(type, f0, SAMPLE_FREQUENCY, gain, Q);
+    eq.getNewCoefficients(chainControlSet.coeffs[band]);
+
+    publishChainControlSet();
+}
+
+void cppdsp_set_eq_band_steps(unsigned band, int type, int32_t freqPos, int32_t gainPos, int32_t qPos) {
+
+    if (band >= EQ_STAGES) {
+        return;
+    }
+
+    initChainControlSet();
+
+    //Table based design, no floating point math on the coefficient path
+    EQ32Base eq;
+    eq.setSamplingFrequency(SAMPLE_FREQUENCY, 0);
+    eq.designEQTable(type, freqPos, gainPos, qPos);
+    eq.getNewCoefficients(chainControlSet.coeffs[band]);
+
+    publishChainControlSet();
+}
+
+void cppdsp_set_eq_band_gain_steps(unsigned band, int32_t gainPos) {
+
+    if (band >= EQ_STAGES) {
+        return;
+    }
+
+    initChainControlSet();
+    cppdsp_set_eq_band_steps(band, eqParams[band].type, eqFreqPos[band], gainPos, eqQPos[band]);
+}
+
+int cppdsp_load_preset(const uint8_t *data, size_t size) {
+
+    DspPreset preset;
+    int err = dspPresetParse(data, size, preset);
+
+    if (err != DSP_PRESET_OK) {
+        return err;
+    }
+
+    //The chain has fewer stages than the format allows
+    if ((preset.stageMask >> EQ_STAGES) != 0 ||
+        ((preset.present & DspPreset::HAS_ACTIVE) && preset.activeStages > EQ_STAGES)) {
+        return DSP_PRESET_ERR_RECORD;
+    }
+
+    initChainControlSet();
+
+    //Parts missing in the preset keep their current settings
+    for (int s = 0; s < EQ_STAGES; ++s) {
+        if (preset.stageMask & (1u << s)) {
+            for (int i = 0; i < BIQUAD_COEFFS; ++i) {
+                chainControlSet.coeffs[s][i] = preset.stages[s].coeffs[i];
+            }
+        }
+    }
+    if (preset.present & DspPreset::HAS_ACTIVE) {
+        chainControlSet.activeStages = preset.activeStages;
+    }
+    if (preset.present & DspPreset::HAS_GAIN_INPUT) {
+        chainControlSet.gain[DSP_PRESET_INPUT] = preset.gain[DSP_PRESET_INPUT];
+        chainControlSet.shift[DSP_PRESET_INPUT] = preset.shift[DSP_PRESET_INPUT];
+    }
+    if (preset.present & DspPreset::HAS_GAIN_OUTPUT) {
+        chainControlSet.gain[DSP_PRESET_OUTPUT] = preset.gain[DSP_PRESET_OUTPUT];
+        chainControlSet.shift[DSP_PRESET_OUTPUT] = preset.shift[DSP_PRESET_OUTPUT];
+    }
+    if (preset.present & DspPreset::HAS_LIMITER) {
+        chainControlSet.limThreshold = preset.limThreshold;
+        chainControlSet.limLookahead = preset.limLookahead;
+        chainControlSet.limHold = preset.limHold;
+        chainControlSet.limRelease = preset.limRelease;
+    }
+
+    //All parts switch together at the next block boundary
+    publishChainControlSet();
+    return DSP_PRESET_OK;
 }
@@ -9,14 +9,58 @@
 #define __CPP_DSP_H__
 
 #include <stdint.h>
+#include <stddef.h>
 #include "global_defines.h"
 
 extern "C" {
 
+// Designs the default chain into its static storage, builds the graph
+// and clears all filter and limiter states. It also resets the settings
+// of the control task, so call it once before the DSP and control tasks
+// start (audio_effects does, before it hands out the block memory);
+// calling it again resets the chain to the defaults. Must not run
+// concurrently with cppdsp_set_eq_band() or cppdsp_load_preset().
 void cppdsp_init_eq();
 
 void cppdsp_process_eq(int32_t inSamps[NUM_CHANS]);
 
+// samples interleaved: samples[frame * NUM_CHANS + channel]; they pass
+// unchanged until cppdsp_init_eq() was called
+void cppdsp_process_block(int32_t samples[], size_t frames);
+
+// Redesigns one EQ band on the calling (control) task and hands the new
+// coefficients to the DSP, which takes them at its next block boundary.
+// type is an EQ32 filter type. Only one task may call this function.
+void cppdsp_set_eq_band(unsigned band, int type, double f0, double gain, double Q);
+
+// Same as cppdsp_set_eq_band(), but designed from the EQ32 design tables
+// for cheap updates from slider input. Positions are table steps with
+// EQ32_TABLE_FRAC_BITS fractional bits, see eq32_tables.h.
+void cppdsp_set_eq_band_steps(unsigned band, int type, int32_t freqPos, int32_t gainPos, int32_t qPos);
+
+// Sets the gain of one band of the default chain from the design tables,
+// its type, frequency and Q stay at the defaults: the front panel sliders
+// of ui_handler. gainPos as above, same calling task.
+void cppdsp_set_eq_band_gain_steps(unsigned band, int32_t gainPos);
+
+// Checks a binary preset (see dsp_preset.h), e.g. read from flash or
+// collected with DspPresetStream, and hands its settings to the DSP. All
+// of them take effect together at the next block boundary, no filter
+// design is done. Returns 0 or a negative DSP_PRESET_ERR_* code.
+// Same calling task as cppdsp_set_eq_band().
+int cppdsp_load_preset(const uint8_t *data, size_t size);
+
 }
 
+#ifdef __cplusplus
+class DspNode;
+
+// Host builds: runs an extra in-place node, e.g. the FFT convolver of the
+// host tools, between the EQ (or multiband compressor) and the limiter; 0
+// removes it. Rebuilds the graph and clears all states, so call it on the
+// DSP task between blocks. Before cppdsp_init_eq() the node is only stored
+// and init puts it into the graph. The node is not owned.
+void cppdsp_set_external_node(DspNode *node);
+#endif
+
 #endif
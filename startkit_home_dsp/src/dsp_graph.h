@@ -0,0 +1,200 @@
+/*---------------------------------------------------------------------------*\
+|   Static Block Processing Graph                                             |
+|                                                                             |
+|   A graph is a list of nodes that run in the order they were added. Each   |
+|   node reads one or more interleaved blocks and writes one. Block 0 is the |
+|   audio block handed to process(), blocks 1..NumScratch are scratch         |
+|   buffers owned by the graph, e.g. for parallel branches joined by a       |
+|   mixer. Node and buffer storage is static: nothing is allocated, nodes    |
+|   are plain objects owned by the caller.                                    |
+|                                                                             |
+|   compile() checks the wiring once, process() then dispatches each node    |
+|   one virtual call per block; all per-sample loops are inside the nodes.   |
+\*---------------------------------------------------------------------------*/
+
+#ifndef DSP_GRAPH_H
+#define DSP_GRAPH_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// maximum number of inputs of one node (mixer)
+#ifndef DSP_NODE_MAX_INPUTS
+#define DSP_NODE_MAX_INPUTS 4
+#endif
+
+// interface of a graph node
+class DspNode
+{
+public:
+    DspNode(int numInputs = 1) : numInputs(numInputs) {}
+    virtual ~DspNode(void) {}
+
+    // in[] holds numInputs interleaved blocks, out may be the same block
+    // as in[0]; frames does not exceed the graph's MaxFrames
+    virtual void processBlock(int32_t *const in[], int32_t *out, size_t frames) = 0;
+
+    // clears filter and delay memories
+    virtual void reset(void) {}
+
+    int getNumInputs(void) const
+    {
+        return numInputs;
+    }
+
+protected:
+    int numInputs;
+
+    // for nodes that work in place
+    static void copyBlock(const int32_t *in, int32_t *out, size_t samples)
+    {
+        if (in != out)
+            for (size_t i=0; i<samples; i++)
+                out[i] = in[i];
+    }
+};
+
+// scratch blocks of a graph; a graph without any has no storage for them
+template <int NumScratch, int Samples>
+struct DspScratch
+{
+    int32_t blocks[NumScratch][Samples];
+
+    int32_t *block(int b)
+    {
+        return blocks[b];
+    }
+};
+
+template <int Samples>
+struct DspScratch<0, Samples>
+{
+    int32_t *block(int)
+    {
+        return 0;
+    }
+};
+
+template <int MaxNodes, int NumScratch, int NumChans, int MaxFrames>
+class DspGraph
+{
+public:
+    DspGraph(void)
+    {
+        clear();
+    }
+
+    void clear(void)
+    {
+        numNodes = 0;
+        compiled = false;
+    }
+
+    // appends a node reading the blocks inputs[0..node.getNumInputs()-1]
+    // and writing block output, returns false if the graph is full or a
+    // block index is out of range
+    bool addNode(DspNode &node, const int inputs[], int output)
+    {
+        if (numNodes >= MaxNodes || node.getNumInputs() < 1 ||
+            node.getNumInputs() > DSP_NODE_MAX_INPUTS || !validBlock(output))
+            return false;
+
+        Step &step = steps[numNodes];
+        for (int k=0; k<node.getNumInputs(); k++)
+        {
+            if (!validBlock(inputs[k]))
+                return false;
+            step.inputs[k] = inputs[k];
+        }
+        step.node = &node;
+        step.output = output;
+        numNodes++;
+        compiled = false;
+        return true;
+    }
+
+    // single input node
+    bool addNode(DspNode &node, int input, int output)
+    {
+        return addNode(node, &input, output);
+    }
+
+    // checks that every scratch block is written before it is read,
+    // process() does nothing until this returned true
+    bool compile(void)
+    {
+        bool written[NumScratch + 1];
+
+        written[0] = true;
+        for (int b=1; b<=NumScratch; b++)
+            written[b] = false;
+
+        for (int n=0; n<numNodes; n++)
+        {
+            for (int k=0; k<steps[n].node->getNumInputs(); k++)
+                if (!written[steps[n].inputs[k]])
+                    return false;
+            written[steps[n].output] = true;
+        }
+
+        compiled = true;
+        return true;
+    }
+
+    void reset(void)
+    {
+        for (int n=0; n<numNodes; n++)
+            steps[n].node->reset();
+    }
+
+    // block interleaved: block[frame * NumChans + channel], processed in
+    // chunks of at most MaxFrames
+    void process(int32_t *block, size_t frames)
+    {
+        int32_t *blocks[NumScratch + 1];
+        int32_t *in[DSP_NODE_MAX_INPUTS];
+
+        if (!compiled)
+            return;
+
+        for (int b=1; b<=NumScratch; b++)
+            blocks[b] = scratch.block(b-1);
+
+        while (frames > 0)
+        {
+            size_t chunk = frames < (size_t) MaxFrames ? frames : (size_t) MaxFrames;
+
+            blocks[0] = block;
+            for (int n=0; n<numNodes; n++)
+            {
+                const Step &step = steps[n];
+                for (int k=0; k<step.node->getNumInputs(); k++)
+                    in[k] = blocks[step.inputs[k]];
+                step.node->processBlock(in, blocks[step.output], chunk);
+            }
+
+            block += chunk * NumChans;
+            frames -= chunk;
+        }
+    }
+
+private:
+    struct Step
+    {
+        DspNode *node;
+        int inputs[DSP_NODE_MAX_INPUTS];
+        int output;
+    };
+
+    Step steps[MaxNodes];
+    int numNodes;
+    bool compiled;
+    DspScratch<NumScratch, MaxFrames * NumChans> scratch;
+
+    static bool validBlock(int b)
+    {
+        return b >= 0 && b <= NumScratch;
+    }
+};
+
+#endif  // DSP_GRAPH_H
@@ -0,0 +1,43 @@
+/*
+ * dsp_load.c
+ *
+ *  Processing load statistics of the DSP task.
+ */
+
+#include "dsp_load.h"
+
+void dsp_load_reset(dsp_load_stats_t *stats, uint32_t deadline_ticks)
+{
+  stats->passes = 0;
+  stats->deadline_misses = 0;
+  stats->deadline_ticks = deadline_ticks;
+  stats->min_ticks = 0xFFFFFFFF;
+  stats->max_ticks = 0;
+  stats->sum_ticks = 0;
+}
+
+void dsp_load_update(dsp_load_stats_t *stats, uint32_t ticks)
+{
+  stats->passes++;
+  stats->sum_ticks += ticks;
+  if (ticks < stats->min_ticks)
+    stats->min_ticks = ticks;
+  if (ticks > stats->max_ticks)
+    stats->max_ticks = ticks;
+  if (ticks > stats->deadline_ticks)
+    stats->deadline_misses++;
+}
+
+uint32_t dsp_load_mean(const dsp_load_stats_t *stats)
+{
+  if (stats->passes == 0)
+    return 0;
+  return (uint32_t) (stats->sum_ticks / stats->passes);
+}
+
+uint32_t dsp_load_peak_percent(const dsp_load_stats_t *stats)
+{
+  if (stats->deadline_ticks == 0)
+    return 0;
+  return (uint32_t) (((uint64_t) stats->max_ticks * 100) / stats->deadline_ticks);
+}
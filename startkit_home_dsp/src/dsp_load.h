@@ -0,0 +1,51 @@
+/*
+ * dsp_load.h
+ *
+ *  Processing load statistics of the DSP task. The same accumulator is
+ *  fed with reference timer ticks on the device and with std::chrono
+ *  nanoseconds in host builds.
+ */
+
+#ifndef DSP_LOAD_H_
+#define DSP_LOAD_H_
+
+#include <stdint.h>
+
+typedef struct dsp_load_stats_t {
+  uint32_t passes;            // number of measured processing passes
+  uint32_t deadline_misses;   // passes that took longer than deadline_ticks
+  uint32_t deadline_ticks;    // time budget of one pass
+  uint32_t min_ticks;
+  uint32_t max_ticks;
+  uint64_t sum_ticks;
+} dsp_load_stats_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void dsp_load_reset(dsp_load_stats_t *stats, uint32_t deadline_ticks);
+
+void dsp_load_update(dsp_load_stats_t *stats, uint32_t ticks);
+
+uint32_t dsp_load_mean(const dsp_load_stats_t *stats);
+
+// load of the slowest pass in percent of the deadline
+uint32_t dsp_load_peak_percent(const dsp_load_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#if defined(__cplusplus) && !defined(__xcore__)
+#include <chrono>
+
+// host time base in nanoseconds for dsp_load_update()
+static inline uint32_t dsp_load_host_ticks(void)
+{
+  return (uint32_t) std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+#endif
+
+#endif /* DSP_LOAD_H_ */
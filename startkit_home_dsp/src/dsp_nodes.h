@@ -0,0 +1,299 @@
+/*---------------------------------------------------------------------------*\
+|   Node Types for the Block Processing Graph                                 |
+|                                                                             |
+|   Biquad cascade, FIR, gain, limiter, dynamics, multiband dynamics, delay,  |
+|   mixer and crossover nodes. All parameters can be changed at runtime, all  |
+|   memory is part of the node object. Gains are Q2.30 (1.0 = 1 << 30) with   |
+|   an additional power-of-two shift; results are saturated to 32 bits.       |
+\*---------------------------------------------------------------------------*/
+
+#ifndef DSP_NODES_H
+#define DSP_NODES_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "dsp_graph.h"
+#include "biquad_cascade.h"
+#include "fir32.h"
+#include "limiter32.h"
+#include "dynamics32.h"
+#include "multiband_dynamics.h"
+#include "lr_crossover.h"
+
+// 1.0 in the gain format of the nodes
+#define DSP_GAIN_ONE ((int32_t) 1 << 30)
+
+// range of the GainNode shift, the product is shifted right by 30 - shift
+#define DSP_SHIFT_MIN -31
+#define DSP_SHIFT_MAX 30
+
+static inline int32_t dspSaturate(int64_t x)
+{
+    if (x > 0x7FFFFFFF)
+        return 0x7FFFFFFF;
+    if (x < -(int64_t) 0x80000000)
+        return (int32_t) 0x80000000;
+    return (int32_t) x;
+}
+
+// up to MaxStages biquads, setActiveStages() selects how many are run
+template <int MaxStages, int NumChans>
+class BiquadNode : public DspNode, public BiquadCascade<MaxStages, NumChans>
+{
+public:
+    BiquadNode(void) {}
+
+    BiquadNode(const BiquadParams params[MaxStages], double fs)
+        : BiquadCascade<MaxStages, NumChans>(params, fs) {}
+
+    void processBlock(int32_t *const in[], int32_t *out, size_t frames)
+    {
+        copyBlock(in[0], out, frames * NumChans);
+        this->BiquadCascade<MaxStages, NumChans>::processBlock(out, frames);
+    }
+
+    void reset(void)
+    {
+        this->resetStates();
+    }
+};
+
+// out = in * gain * 2^shift
+template <int NumChans>
+class GainNode : public DspNode
+{
+public:
+    GainNode(int32_t gain = DSP_GAIN_ONE, int shift = 0)
+    {
+        setGain(gain, shift);
+    }
+
+    // gain in Q2.30, shift in [DSP_SHIFT_MIN, DSP_SHIFT_MAX]
+    void setGain(int32_t gain, int shift = 0)
+    {
+        if (shift > DSP_SHIFT_MAX)
+            shift = DSP_SHIFT_MAX;
+        if (shift < DSP_SHIFT_MIN)
+            shift = DSP_SHIFT_MIN;
+
+        this->gain = gain;
+        this->shift = 30 - shift;
+    }
+
+    void processBlock(int32_t *const in[], int32_t *out, size_t frames)
+    {
+        const int32_t *x = in[0];
+
+        // plain attenuation by a power of two cannot overflow
+        if (gain == DSP_GAIN_ONE && shift >= 30)
+        {
+            for (size_t i=0; i<frames * NumChans; i++)
+                out[i] = x[i] >> (shift - 30);
+            return;
+        }
+
+        for (size_t i=0; i<frames * NumChans; i++)
+            out[i] = dspSaturate(((int64_t) gain * x[i]) >> shift);
+    }
+
+private:
+    int32_t gain;
+    int     shift;      // total right shift of the product
+};
+
+template <int NumChans, int MaxLookahead = MAX_LIMITER_LOOKAHEAD>
+class LimiterNode : public DspNode, public Limiter32N<NumChans, MaxLookahead>
+{
+public:
+    LimiterNode(void) {}
+
+    LimiterNode(double threshold, double tAtt, double tHold, double tRel, int32_t fs)
+        : Limiter32N<NumChans, MaxLookahead>(threshold, tAtt, tHold, tRel, fs) {}
+
+    void processBlock(int32_t *const in[], int32_t *out, size_t frames)
+    {
+        copyBlock(in[0], out, frames * NumChans);
+        for (size_t n=0; n<frames; n++)
+            this->process(out + n * NumChans);
+    }
+
+    void reset(void)
+    {
+        this->resetStates();
+    }
+};
+
+// linked compressor/expander on all channels, see dynamics32.h
+template <int NumChans>
+class DynamicsNode : public DspNode, public Dynamics32N<NumChans>
+{
+public:
+    DynamicsNode(void) {}
+
+    DynamicsNode(double threshold, double ratio, double knee,
+                 double tAtt, double tRel, int32_t fs)
+        : Dynamics32N<NumChans>(threshold, ratio, knee, tAtt, tRel, fs) {}
+
+    void processBlock(int32_t *const in[], int32_t *out, size_t frames)
+    {
+        copyBlock(in[0], out, frames * NumChans);
+        Dynamics32N<NumChans>::processBlock(out, frames);
+    }
+
+    void reset(void)
+    {
+        this->resetStates();
+    }
+};
+
+// FIR with up to MaxTaps taps, e.g. room correction, see fir32.h
+template <int MaxTaps, int NumChans>
+class FIRNode : public DspNode, public FIR32<MaxTaps, NumChans>
+{
+public:
+    FIRNode(void) {}
+
+    void processBlock(int32_t *const in[], int32_t *out, size_t frames)
+    {
+        copyBlock(in[0], out, frames * NumChans);
+        FIR32<MaxTaps, NumChans>::processBlock(out, frames);
+    }
+
+    void reset(void)
+    {
+        this->resetStates();
+    }
+};
+
+// NumBands band compressor in place, see multiband_dynamics.h
+template <int NumChans, int NumBands>
+class MultibandNode : public DspNode, public MultibandDynamics<NumChans, NumBands>
+{
+public:
+    MultibandNode(void) {}
+
+    void processBlock(int32_t *const in[], int32_t *out, size_t frames)
+    {
+        copyBlock(in[0], out, frames * NumChans);
+        MultibandDynamics<NumChans, NumBands>::processBlock(out, frames);
+    }
+
+    void reset(void)
+    {
+        this->resetStates();
+    }
+};
+
+// delays all channels by 0..MaxDelay frames
+template <int NumChans, int MaxDelay>
+class DelayNode : public DspNode
+{
+public:
+    DelayNode(int delay = 0)
+    {
+        setDelay(delay);
+        reset();
+    }
+
+    void setDelay(int delay)
+    {
+        if (delay < 0)
+            delay = 0;
+        if (delay > MaxDelay)
+            delay = MaxDelay;
+
+        this->delay = delay;
+    }
+
+    void reset(void)
+    {
+        for (int i=0; i<(MaxDelay + 1) * NumChans; i++)
+            mem[i] = 0;
+        writePos = 0;
+    }
+
+    void processBlock(int32_t *const in[], int32_t *out, size_t frames)
+    {
+        const int32_t *x = in[0];
+
+        for (size_t n=0; n<frames; n++)
+        {
+            int readPos = writePos - delay;
+            if (readPos < 0)
+                readPos += MaxDelay + 1;
+
+            for (int c=0; c<NumChans; c++)
+            {
+                mem[writePos * NumChans + c] = x[n * NumChans + c];
+                out[n * NumChans + c] = mem[readPos * NumChans + c];
+            }
+
+            writePos = writePos < MaxDelay ? writePos + 1 : 0;
+        }
+    }
+
+private:
+    int32_t mem[(MaxDelay + 1) * NumChans];
+    int     writePos;
+    int     delay;
+};
+
+// out = sum of in[k] * gain[k], gains in Q2.30, saturated; up to 16 inputs
+template <int NumChans, int NumInputs>
+class MixerNode : public DspNode
+{
+    // |gain * in| <= 2^62, so each product gives up GuardBits =
+    // ceil(log2(NumInputs)) low bits before the sum, which then cannot
+    // overflow 64 bits; unity gains stay exact
+    enum { GuardBits = NumInputs <= 1 ? 0 : NumInputs <= 2 ? 1 : NumInputs <= 4 ? 2 :
+                       NumInputs <= 8 ? 3 : 4 };
+    typedef char CheckNumInputs[NumInputs <= 16 ? 1 : -1];
+
+public:
+    MixerNode(void) : DspNode(NumInputs)
+    {
+        for (int k=0; k<NumInputs; k++)
+            gains[k] = DSP_GAIN_ONE;
+    }
+
+    void setGain(int input, int32_t gain)
+    {
+        if (input >= 0 && input < NumInputs)
+            gains[input] = gain;
+    }
+
+    void processBlock(int32_t *const in[], int32_t *out, size_t frames)
+    {
+        for (size_t i=0; i<frames * NumChans; i++)
+        {
+            int64_t acc = 0;
+            for (int k=0; k<NumInputs; k++)
+                acc += ((int64_t) gains[k] * in[k][i]) >> GuardBits;
+            out[i] = dspSaturate(acc >> (30 - GuardBits));
+        }
+    }
+
+private:
+    int32_t gains[NumInputs];
+};
+
+// Splits channels 0..NumIn-1 of each frame into NumBands bands, the graph
+// runs NumIn * NumBands channels: out[frame][band * NumIn + channel]
+template <int NumIn, int NumBands>
+class CrossoverNode : public DspNode, public LRCrossover<NumIn, NumBands>
+{
+public:
+    CrossoverNode(void) {}
+
+    void processBlock(int32_t *const in[], int32_t *out, size_t frames)
+    {
+        this->LRCrossover<NumIn, NumBands>::processBlock(in[0], NumIn * NumBands, out, frames);
+    }
+
+    void reset(void)
+    {
+        this->resetStates();
+    }
+};
+
+#endif  // DSP_NODES_H
@@ -0,0 +1,184 @@
+/*---------------------------------------------------------------------------*\
+|   Binary Presets for the cppdsp Chain                                       |
+\*---------------------------------------------------------------------------*/
+
+#include "dsp_preset.h"
+#include "dsp_nodes.h"
+
+// header words: magic, version, size
+#define HEADER_BYTES 12
+
+static uint32_t getWord(const uint8_t *p)
+{
+    return (uint32_t) p[0] | ((uint32_t) p[1] << 8) |
+           ((uint32_t) p[2] << 16) | ((uint32_t) p[3] << 24);
+}
+
+uint32_t dspPresetCrc32(const uint8_t *data, size_t size, uint32_t crc)
+{
+    crc = ~crc;
+    for (size_t i=0; i<size; i++)
+    {
+        crc ^= data[i];
+        for (int k=0; k<8; k++)
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+    }
+    return ~crc;
+}
+
+static int checkHeader(const uint8_t *data, size_t size)
+{
+    if (getWord(data) != DSP_PRESET_MAGIC)
+        return DSP_PRESET_ERR_MAGIC;
+
+    // the minor version only adds records, which are skipped
+    if ((getWord(data + 4) & 0xFFFF) != DSP_PRESET_MAJOR)
+        return DSP_PRESET_ERR_VERSION;
+
+    if (size < HEADER_BYTES + 4 || size > DSP_PRESET_MAX_BYTES || (size & 3))
+        return DSP_PRESET_ERR_SIZE;
+
+    return DSP_PRESET_OK;
+}
+
+static int parseRecord(uint32_t tag, const uint8_t *p, uint32_t words, DspPreset &preset)
+{
+    switch (tag)
+    {
+    case DSP_PRESET_NAME:
+        for (uint32_t i=0; i<words*4 && i<DSP_PRESET_NAME_LEN; i++)
+            preset.name[i] = (char) p[i];
+        preset.present |= DspPreset::HAS_NAME;
+        break;
+
+    case DSP_PRESET_EQ_STAGE:
+    {
+        if (words < DSP_PRESET_EQ_STAGE_WORDS)
+            return DSP_PRESET_ERR_RECORD;
+
+        uint32_t s = getWord(p);
+        if (s >= DSP_PRESET_MAX_STAGES)
+            return DSP_PRESET_ERR_RECORD;
+
+        DspPresetStage &stage = preset.stages[s];
+        stage.type = (int32_t) getWord(p + 4);
+        stage.f0   = (int32_t) getWord(p + 8);
+        stage.gain = (int32_t) getWord(p + 12);
+        stage.Q    = (int32_t) getWord(p + 16);
+        for (int i=0; i<BIQUAD_COEFFS; i++)
+            stage.coeffs[i] = (int32_t) getWord(p + 20 + 4*i);
+        preset.stageMask |= 1u << s;
+        break;
+    }
+
+    case DSP_PRESET_EQ_ACTIVE:
+        if (words < 1 || getWord(p) > DSP_PRESET_MAX_STAGES)
+            return DSP_PRESET_ERR_RECORD;
+        preset.activeStages = (int32_t) getWord(p);
+        preset.present |= DspPreset::HAS_ACTIVE;
+        break;
+
+    case DSP_PRESET_GAIN:
+    {
+        if (words < DSP_PRESET_GAIN_WORDS)
+            return DSP_PRESET_ERR_RECORD;
+
+        uint32_t which = getWord(p);
+        int32_t shift = (int32_t) getWord(p + 8);
+        if (which >= DSP_PRESET_GAINS || shift < DSP_SHIFT_MIN || shift > DSP_SHIFT_MAX)
+            return DSP_PRESET_ERR_RECORD;
+
+        preset.gain[which] = (int32_t) getWord(p + 4);
+        preset.shift[which] = shift;
+        preset.present |= which == DSP_PRESET_INPUT ?
+                          DspPreset::HAS_GAIN_INPUT : DspPreset::HAS_GAIN_OUTPUT;
+        break;
+    }
+
+    case DSP_PRESET_LIMITER:
+        // a negative release coefficient overflows 0x7FFFFFFF - release
+        if (words < DSP_PRESET_LIMITER_WORDS || (int32_t) getWord(p) <= 0 ||
+            (int32_t) getWord(p + 8) < 0 || (int32_t) getWord(p + 12) < 0)
+            return DSP_PRESET_ERR_RECORD;
+        preset.limThreshold = (int32_t) getWord(p);
+        preset.limLookahead = (int32_t) getWord(p + 4);
+        preset.limHold      = (int32_t) getWord(p + 8);
+        preset.limRelease   = (int32_t) getWord(p + 12);
+        preset.present |= DspPreset::HAS_LIMITER;
+        break;
+
+    default:
+        // newer record type, skipped
+        break;
+    }
+
+    return DSP_PRESET_OK;
+}
+
+int dspPresetParse(const uint8_t *data, size_t size, DspPreset &preset)
+{
+    size_t total, pos;
+    int err;
+
+    if (size < HEADER_BYTES)
+        return DSP_PRESET_ERR_SIZE;
+
+    total = getWord(data + 8);
+    err = checkHeader(data, total);
+    if (err != DSP_PRESET_OK)
+        return err;
+
+    if (total > size)
+        return DSP_PRESET_ERR_SIZE;
+
+    if (dspPresetCrc32(data, total - 4) != getWord(data + total - 4))
+        return DSP_PRESET_ERR_CRC;
+
+    preset.present = 0;
+    preset.stageMask = 0;
+    preset.activeStages = 0;
+    for (int i=0; i<=DSP_PRESET_NAME_LEN; i++)
+        preset.name[i] = 0;
+
+    for (pos = HEADER_BYTES; pos < total - 4; )
+    {
+        uint32_t rec = getWord(data + pos);
+        uint32_t words = rec >> 16;
+
+        pos += 4;
+        if (pos + 4*words > total - 4)
+            return DSP_PRESET_ERR_RECORD;
+
+        err = parseRecord(rec & 0xFFFF, data + pos, words, preset);
+        if (err != DSP_PRESET_OK)
+            return err;
+        pos += 4*words;
+    }
+
+    return DSP_PRESET_OK;
+}
+
+int DspPresetStream::push(const uint8_t *data, size_t size)
+{
+    for (size_t i=0; i<size; i++)
+    {
+        if (fill >= DSP_PRESET_MAX_BYTES)
+            return DSP_PRESET_ERR_SIZE;
+
+        buffer[fill++] = data[i];
+
+        if (fill == HEADER_BYTES)
+        {
+            int err;
+            expected = getWord(buffer + 8);
+            err = checkHeader(buffer, expected);
+            if (err != DSP_PRESET_OK)
+                return err;
+        }
+
+        if (expected && fill == expected)
+            return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,135 @@
+/*---------------------------------------------------------------------------*\
+|   Binary Presets for the cppdsp Chain                                       |
+|                                                                             |
+|   A preset holds ready-to-use fixed-point settings, so switching to it      |
+|   needs no filter design on the device. Layout, all fields 32-bit little    |
+|   endian words:                                                             |
+|                                                                             |
+|       magic 'DSPR', version (major | minor << 16), total size in bytes      |
+|       records: tag | (payload words << 16), payload words...                |
+|       CRC-32 (IEEE) of all preceding bytes                                  |
+|                                                                             |
+|   Records of unknown tags are skipped, so presets of a newer minor version  |
+|   stay readable; a new major version is rejected. The host tool             |
+|   host/presetc.cpp compiles text presets.                                   |
+\*---------------------------------------------------------------------------*/
+
+#ifndef DSP_PRESET_H
+#define DSP_PRESET_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "eq32.h"
+
+#define DSP_PRESET_MAGIC        0x52505344  // "DSPR"
+#define DSP_PRESET_MAJOR        1
+#define DSP_PRESET_MINOR        0
+#define DSP_PRESET_VERSION      (DSP_PRESET_MAJOR | (DSP_PRESET_MINOR << 16))
+
+#define DSP_PRESET_MAX_STAGES   8
+#define DSP_PRESET_NAME_LEN     32
+#define DSP_PRESET_MAX_BYTES    512
+
+// record tags and payload words
+enum {
+    DSP_PRESET_NAME = 1,        // up to DSP_PRESET_NAME_LEN chars, 0 padded
+    DSP_PRESET_EQ_STAGE = 2,    // index, type, f0 (1/100 Hz), gain (dB Q8.24),
+                                // Q (Q8.24), b0, b1, b2, -a1, -a2 (Q8.24)
+    DSP_PRESET_EQ_ACTIVE = 3,   // number of active stages
+    DSP_PRESET_GAIN = 4,        // DSP_PRESET_INPUT / _OUTPUT, gain Q2.30, shift
+                                // (DSP_SHIFT_MIN..DSP_SHIFT_MAX)
+    DSP_PRESET_LIMITER = 5      // threshold Q1.31 (> 0), lookahead, hold
+                                // (samples, >= 0), release coefficient Q31 (>= 0)
+};
+
+enum { DSP_PRESET_INPUT, DSP_PRESET_OUTPUT, DSP_PRESET_GAINS };
+
+#define DSP_PRESET_EQ_STAGE_WORDS   (5 + BIQUAD_COEFFS)
+#define DSP_PRESET_GAIN_WORDS       3
+#define DSP_PRESET_LIMITER_WORDS    4
+
+// parse results
+enum {
+    DSP_PRESET_OK = 0,
+    DSP_PRESET_ERR_SIZE = -1,
+    DSP_PRESET_ERR_MAGIC = -2,
+    DSP_PRESET_ERR_VERSION = -3,
+    DSP_PRESET_ERR_CRC = -4,
+    DSP_PRESET_ERR_RECORD = -5
+};
+
+struct DspPresetStage
+{
+    int32_t type;
+    int32_t f0;                             // 1/100 Hz
+    int32_t gain;                           // dB, Q8.24
+    int32_t Q;                              // Q8.24
+    int32_t coeffs[BIQUAD_COEFFS];          // { b0, b1, b2, -a1, -a2 }
+};
+
+// decoded preset, 'present' flags which parts were in the binary
+struct DspPreset
+{
+    enum {
+        HAS_NAME = 1 << 0,
+        HAS_ACTIVE = 1 << 1,
+        HAS_GAIN_INPUT = 1 << 2,
+        HAS_GAIN_OUTPUT = 1 << 3,
+        HAS_LIMITER = 1 << 4
+    };
+
+    uint32_t present;
+    uint32_t stageMask;                     // bit s set: stages[s] valid
+    char     name[DSP_PRESET_NAME_LEN + 1];
+    int32_t  activeStages;
+    DspPresetStage stages[DSP_PRESET_MAX_STAGES];
+    int32_t  gain[DSP_PRESET_GAINS];        // Q2.30
+    int32_t  shift[DSP_PRESET_GAINS];
+    int32_t  limThreshold;                  // Q1.31
+    int32_t  limLookahead;                  // samples
+    int32_t  limHold;                       // samples
+    int32_t  limRelease;                    // Q31
+};
+
+// CRC-32 (IEEE 802.3), as used for the preset checksum
+uint32_t dspPresetCrc32(const uint8_t *data, size_t size, uint32_t crc = 0);
+
+// checks and decodes a binary preset, returns DSP_PRESET_OK or an error
+int dspPresetParse(const uint8_t *data, size_t size, DspPreset &preset);
+
+// Collects a preset that arrives in pieces, e.g. over I2C. push() returns
+// 1 when the preset is complete, 0 while more bytes are expected and a
+// negative DSP_PRESET_ERR_* on a broken header or overflow.
+class DspPresetStream
+{
+public:
+    DspPresetStream(void)
+    {
+        restart();
+    }
+
+    void restart(void)
+    {
+        fill = 0;
+        expected = 0;
+    }
+
+    int push(const uint8_t *data, size_t size);
+
+    const uint8_t *data(void) const
+    {
+        return buffer;
+    }
+
+    size_t size(void) const
+    {
+        return fill;
+    }
+
+private:
+    uint8_t buffer[DSP_PRESET_MAX_BYTES];
+    size_t  fill;
+    size_t  expected;                       // total size once the header is in
+};
+
+#endif  // DSP_PRESET_H
@@ -0,0 +1,110 @@
+/*---------------------------------------------------------------------------*\
+|   Fixed-Point Feed-Forward Compressor / Expander, settings                  |
+|                                                                             |
+|   dB settings are converted to log2 units here, on the control side.       |
+\*---------------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include "dynamics32.h"
+
+// log2(10) / 20: dB -> log2 units
+#define DB_TO_LOG2 0.16609640474436813
+
+static int32_t dbToLog2(double db)
+{
+    double l = db * DB_TO_LOG2;
+
+    if (l < -29.)
+        l = -29.;
+    if (l > 29.)
+        l = 29.;
+    return (int32_t)(l * (1 << 24));
+}
+
+// knee widths below 0.1 dB are a hard knee
+static int32_t kneeHalf(double knee)
+{
+    return knee < 0.1 ? 0 : dbToLog2(knee / 2.);
+}
+
+// a^n in Q31 by repeated squaring
+static int32_t powQ31(int32_t a, size_t n)
+{
+    int32_t result = 0x7FFFFFFF;
+
+    while (n > 0)
+    {
+        if (n & 1)
+            result = (int32_t)(((int64_t)result * a) >> 31);
+        a = (int32_t)(((int64_t)a * a) >> 31);
+        n >>= 1;
+    }
+    return result;
+}
+
+Dynamics32Base::Dynamics32Base(void)
+{
+    setCompressor(0., 1., 0.);
+    setExpander(-180., 1., 0.);
+    setRange(120.);
+    setTimes(0.01, 0.1, 48000);
+    resetStates();
+}
+
+Dynamics32Base::Dynamics32Base(double threshold, double ratio, double knee,
+                               double tAtt, double tRel, int32_t fs)
+{
+    setCompressor(threshold, ratio, knee);
+    setExpander(-180., 1., 0.);
+    setRange(120.);
+    setTimes(tAtt, tRel, fs);
+    resetStates();
+}
+
+void Dynamics32Base::setCompressor(double threshold, double ratio, double knee)
+{
+    double slope = ratio > 1. ? 1. - 1. / ratio : 0.;
+
+    compThreshold = dbToLog2(threshold);
+    compKneeHalf = kneeHalf(knee);
+    compSlope = (int32_t)(slope * (1 << 30));
+    compKneeScale = compKneeHalf > 0 ?
+        (int64_t)(slope / (4. * compKneeHalf / (1 << 24)) * (1 << 24)) : 0;
+}
+
+void Dynamics32Base::setExpander(double threshold, double ratio, double knee)
+{
+    double slope = ratio > 1. ? ratio - 1. : 0.;
+
+    expThreshold = dbToLog2(threshold);
+    expKneeHalf = kneeHalf(knee);
+    expSlope = (int64_t)(slope * (1 << 24));
+    expKneeScale = expKneeHalf > 0 ?
+        (int64_t)(slope / (4. * expKneeHalf / (1 << 24)) * (1 << 24)) : 0;
+}
+
+// largest attenuation in dB (positive), at most 174 dB
+void Dynamics32Base::setRange(double range)
+{
+    range = range < 0. ? 0. : range;
+    this->range = -dbToLog2(-range);
+}
+
+void Dynamics32Base::setTimes(double tAtt, double tRel, int32_t fs)
+{
+    bAtt = onePoleCoeff(tAtt, fs);
+    aAtt = 0x7FFFFFFF - bAtt;
+    bRel = onePoleCoeff(tRel, fs);
+    aRel = 0x7FFFFFFF - bRel;
+    blockFrames = 0;                            // block coefficients are stale
+}
+
+// a block of n samples decays by a^n
+void Dynamics32Base::setBlockFrames(size_t frames)
+{
+    aAttBlk = powQ31(aAtt, frames);
+    bAttBlk = 0x7FFFFFFF - aAttBlk;
+    aRelBlk = powQ31(aRel, frames);
+    bRelBlk = 0x7FFFFFFF - aRelBlk;
+    blockFrames = frames;
+}
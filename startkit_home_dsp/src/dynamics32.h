@@ -0,0 +1,166 @@
+/*---------------------------------------------------------------------------*\
+|   Fixed-Point Feed-Forward Compressor / Expander                            |
+|                                                                             |
+|   The detector takes the peak of all channels over a block, so one          |
+|   envelope serves every channel (linked stereo). Envelope and gain          |
+|   computer work in the log2 domain, Q8.24 with 1.0 = 6.02 dB: the block     |
+|   peak costs one fix_log2(), the gain one fix_exp2(). The envelope uses     |
+|   the one-pole smoothing of Limiter32 with attack and release               |
+|   coefficients raised to the block length, and the linear gain is           |
+|   interpolated across the block, so per sample only the peak search and    |
+|   one multiply per channel remain.                                          |
+|                                                                             |
+|   Compressor: threshold, ratio and soft knee (quadratic). Expander: ratio   |
+|   below its threshold, a large ratio gives a gate; range limits the total   |
+|   attenuation. The gain never exceeds 0 dB, make-up gain is a GainNode.     |
+\*---------------------------------------------------------------------------*/
+
+#ifndef DYNAMICS32_H
+#define DYNAMICS32_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "fixmath.h"
+#include "limiter32.h"
+
+// channel independent part: settings, envelope and gain computer
+class Dynamics32Base
+{
+public:
+    // no compression, no expansion, 10 ms attack, 100 ms release at 48 kHz
+    Dynamics32Base(void);
+
+    // compressor with threshold (dB), ratio (>= 1), knee width (dB)
+    Dynamics32Base(double threshold, double ratio, double knee,
+                   double tAtt, double tRel, int32_t fs);
+
+    void setCompressor(double threshold, double ratio, double knee);
+    void setExpander(double threshold, double ratio, double knee);
+    void setRange(double range);
+    void setTimes(double tAtt, double tRel, int32_t fs);
+
+    // current gain, Q1.31
+    int32_t getGain(void) const
+    {
+        return gain;
+    }
+
+    // envelope level, log2 of full scale in Q8.24
+    int32_t getEnvelope(void) const
+    {
+        return envelope;
+    }
+
+    void resetStates(void)
+    {
+        envelope = LevelFloor;
+        gain = 0x7FFFFFFF;
+    }
+
+protected:
+    enum { LevelFloor = -(30 << 24) };          // -180 dB, fix_exp2() limit
+
+    int32_t compThreshold;                      // Q8.24 log2
+    int32_t compKneeHalf;                       // half knee width, Q8.24 log2
+    int32_t compSlope;                          // 1 - 1/ratio, Q30
+    int64_t compKneeScale;                      // (1 - 1/ratio) / (2 knee), Q24
+    int32_t expThreshold;
+    int32_t expKneeHalf;
+    int64_t expSlope;                           // ratio - 1, Q24
+    int64_t expKneeScale;                       // (ratio - 1) / (2 knee), Q24
+    int32_t range;                              // largest attenuation, Q8.24
+
+    int32_t aAtt, bAtt, aRel, bRel;             // per sample, Q31
+    int32_t aAttBlk, bAttBlk, aRelBlk, bRelBlk; // per block of blockFrames
+    size_t  blockFrames;
+
+    int32_t envelope;
+    int32_t gain;
+
+    void setBlockFrames(size_t frames);
+
+    // block peak of all channels (magnitude, Q1.31) -> target gain, Q1.31
+    inline int32_t updateGain(uint32_t peak, size_t frames)
+    {
+        int32_t level = peak ? fix_log2(peak, 31) : (int32_t)LevelFloor;
+
+        if (frames != blockFrames)
+            setBlockFrames(frames);
+
+        if (level > envelope)
+            envelope = onePoleSmooth(level, envelope, aAttBlk, bAttBlk);
+        else
+            envelope = onePoleSmooth(level, envelope, aRelBlk, bRelBlk);
+
+        int64_t lin = fix_exp2(gainComputer(envelope), 24) << 1;
+        return lin > 0x7FFFFFFF ? 0x7FFFFFFF : (int32_t)lin;
+    }
+
+    // static curve: level -> gain, both log2 in Q8.24, gain <= 0
+    inline int32_t gainComputer(int32_t level) const
+    {
+        int64_t g = 0;
+        int32_t over = level - compThreshold;
+        int32_t under = expThreshold - level;
+
+        if (over >= compKneeHalf)
+            g -= ((int64_t)over * compSlope) >> 30;
+        else if (over > -compKneeHalf)
+        {
+            int64_t t = over + compKneeHalf;
+            g -= (((t * t) >> 24) * compKneeScale) >> 24;
+        }
+
+        if (under >= expKneeHalf)
+            g -= (under * expSlope) >> 24;
+        else if (under > -expKneeHalf)
+        {
+            int64_t t = under + expKneeHalf;
+            g -= (((t * t) >> 24) * expKneeScale) >> 24;
+        }
+
+        return g < -range ? -range : (int32_t)g;
+    }
+};
+
+template <int NumChans>
+class Dynamics32N : public Dynamics32Base
+{
+public:
+    Dynamics32N(void) : Dynamics32Base() {}
+
+    Dynamics32N(double threshold, double ratio, double knee,
+                double tAtt, double tRel, int32_t fs)
+        : Dynamics32Base(threshold, ratio, knee, tAtt, tRel, fs) {}
+
+    // interleaved block: samples[frame * NumChans + channel]
+    inline void processBlock(int32_t *interleaved, size_t frames)
+    {
+        uint32_t peak = 0;
+
+        if (frames == 0)
+            return;
+
+        for (size_t i=0; i<frames*NumChans; i++)
+        {
+            uint32_t mag = interleaved[i] < 0 ? 0u - (uint32_t)interleaved[i]
+                                              : (uint32_t)interleaved[i];
+            if (mag > peak)
+                peak = mag;
+        }
+
+        // linear ramp from the last gain, the target is reached on the
+        // last frame of the block
+        int32_t target = updateGain(peak, frames);
+        int32_t step = (target - gain) / (int32_t)frames;
+        int32_t g = target - step * (int32_t)(frames - 1);
+
+        for (size_t n=0; n<frames; n++, interleaved+=NumChans, g+=step)
+            for (int c=0; c<NumChans; c++)
+                interleaved[c] = (int32_t)(((int64_t)g * interleaved[c]) >> 31);
+
+        gain = target;
+    }
+};
+
+#endif  // DYNAMICS32_H
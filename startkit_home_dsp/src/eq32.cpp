@@ -21,12 +21,14 @@
 
 #include <math.h>
 #include "eq32.h"
+#include "eq32_tables.h"
+#include "fixmath.h"
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
-EQ32::EQ32(void)
+EQ32Base::EQ32Base(void)
 {
     type = PEAKING_EQ;
     f0 = 1000.;
@@ -34,31 +36,42 @@ EQ32::EQ32(void)
     gain = 0.;
     Q = 0.7071;
     update_filter = false;
+    paramForm = PARAMS_DOUBLE;
+    kind = BIQUAD_BYPASS;
     coefficients[0] = fixed_one;
     coefficients[1] = 0;
     coefficients[2] = 0;
     coefficients[3] = 0;
     coefficients[4] = 0;
-    resetStates();
+    rampLength = 0;
+    rampRemaining = 0;
 }
 
-EQ32::EQ32(int type, double f0, double fs, double gain, double Q)
+EQ32Base::EQ32Base(int type, double f0, double fs, double gain, double Q)
 {
     this->type = type;
     this->f0 = f0;
     this->fs = fs;
     this->gain = gain;
     this->Q = Q;
-    update_filter = false;
+    paramForm = PARAMS_DOUBLE;
+    rampLength = 0;
+    rampRemaining = 0;
     designEQ();
-    resetStates();
+
+    // the designed filter is in effect from the start, so a ramp set
+    // before the first block has defined coefficients to start from
+    for (int i=0; i<BIQUAD_COEFFS; i++)
+        coefficients[i] = newCoefficients[i];
+    kind = classifyBiquad(coefficients);
+    update_filter = false;
 }
 
-EQ32::~EQ32(void)
+EQ32Base::~EQ32Base(void)
 {
 }
 
-void EQ32::setType(int type, int update_coeffs)
+void EQ32Base::setType(int type, int update_coeffs)
 {
     this->type = type;
 
@@ -66,8 +79,10 @@ void EQ32::setType(int type, int update_coeffs)
         designEQ();
 }
 
-void EQ32::setCenterFrequency(double f0, int update_coeffs)
+void EQ32Base::setCenterFrequency(double f0, int update_coeffs)
 {
+    paramsToDouble();
+
     if (f0 < 0)
         f0 = 0;
 
@@ -80,16 +95,20 @@ void EQ32::setCenterFrequency(double f0, int update_coeffs)
         designEQ();
 }
 
-void EQ32::setSamplingFrequency(double fs, int update_coeffs)
+void EQ32Base::setSamplingFrequency(double fs, int update_coeffs)
 {
+    // table positions are relative to the old fs
+    paramsToDouble();
     this->fs = fs;
 
     if (update_coeffs)
         designEQ();
 }
 
-void EQ32::setGain(double gain, int update_coeffs)
+void EQ32Base::setGain(double gain, int update_coeffs)
 {
+    paramsToDouble();
+
     if (gain < -24)
         gain = -24;
 
@@ -102,8 +121,10 @@ void EQ32::setGain(double gain, int update_coeffs)
         designEQ();
 }
 
-void EQ32::setQfactor(double Q, int update_coeffs)
+void EQ32Base::setQfactor(double Q, int update_coeffs)
 {
+    paramsToDouble();
+
     if (Q < 0)
         Q = 0;
 
@@ -116,19 +137,14 @@ void EQ32::setQfactor(double Q, int update_coeffs)
         designEQ();
 }
 
-void EQ32::resetStates(void)
-{
-    for (int i=0; i<EQ_CHANS; i++)
-        for (int j=0; j<BIQUAD_STATES; j++)
-            states[i][j] = 0;
-}
-
-void EQ32::designEQ(void)
+#if !EQ32_FIXED_DESIGN
+void EQ32Base::designEQ(void)
 {
     double b0, b1, b2, a0, a1, a2;
     double omega, cs, sn, alpha, beta, A, S;
     double double_coeffs[BIQUAD_COEFFS];
 
+    paramsToDouble();
     omega = 2.*M_PI*f0/fs;
     cs = cos(omega);
     sn = sin(omega);
@@ -257,21 +273,493 @@ void EQ32::designEQ(void)
 
     setCoefficients(double_coeffs);
 }
+#endif
+
+// linear interpolation in column col of a table with 'steps' rows,
+// pos in table steps with EQ32_TABLE_FRAC_BITS fractional bits
+static int32_t tableLookup(const int32_t *table, int cols, int col, int steps, int32_t pos)
+{
+    const int32_t fracMask = (1 << EQ32_TABLE_FRAC_BITS) - 1;
+    int32_t idx, frac;
+
+    if (pos < 0)
+        pos = 0;
+
+    if (pos > (steps - 1) << EQ32_TABLE_FRAC_BITS)
+        pos = (steps - 1) << EQ32_TABLE_FRAC_BITS;
+
+    idx = pos >> EQ32_TABLE_FRAC_BITS;
+    frac = pos & fracMask;
+
+    if (frac == 0)
+        return table[idx*cols + col];
+
+    int32_t y0 = table[idx*cols + col];
+    int32_t y1 = table[(idx+1)*cols + col];
+    return y0 + (int32_t) (((int64_t) (y1 - y0) * frac) >> EQ32_TABLE_FRAC_BITS);
+}
+
+// inverse of tableLookup() for a rising column: the position at which
+// the interpolated column reaches value, clamped to the table
+static int32_t tablePosition(const int32_t *table, int cols, int col, int steps, int32_t value)
+{
+    int lo = 0, hi = steps - 1;
+
+    if (value <= table[col])
+        return 0;
+
+    if (value >= table[hi*cols + col])
+        return hi << EQ32_TABLE_FRAC_BITS;
+
+    // table[lo] <= value < table[hi]
+    while (hi - lo > 1)
+    {
+        int mid = (lo + hi) / 2;
+
+        if (table[mid*cols + col] <= value)
+            lo = mid;
+        else
+            hi = mid;
+    }
+
+    int32_t y0 = table[lo*cols + col];
+    int32_t y1 = table[hi*cols + col];
+    return (lo << EQ32_TABLE_FRAC_BITS)
+         + (int32_t) (((int64_t) (value - y0) << EQ32_TABLE_FRAC_BITS) / (y1 - y0));
+}
+
+int32_t eq32FreqPos(int32_t f0Hz, int32_t fsHz)
+{
+    int32_t norm = (int32_t) (((int64_t) f0Hz << EQ32_FREQ_BITS) / fsHz);
+
+    return tablePosition(&eq32FreqTable[0][0], EQ32_FREQ_COLS, EQ32_FREQ_NORM,
+                         EQ32_FREQ_STEPS, norm);
+}
+
+int32_t eq32GainPos(int32_t gainCdB)
+{
+    const int32_t maxPos = (EQ32_GAIN_STEPS - 1) << EQ32_TABLE_FRAC_BITS;
+    int32_t pos = (gainCdB - EQ32_GAIN_MIN_DB * 100) * EQ32_GAIN_STEPS_PER_DB
+                  * (1 << EQ32_TABLE_FRAC_BITS) / 100;
+
+    return pos < 0 ? 0 : pos > maxPos ? maxPos : pos;
+}
+
+int32_t eq32QPos(int32_t qMilli)
+{
+    int32_t value = (int32_t) (((int64_t) qMilli << EQ32_Q_BITS) / 1000);
+
+    return tablePosition(&eq32QTable[0][0], EQ32_Q_COLS, EQ32_Q_VALUE, EQ32_Q_STEPS, value);
+}
+
+// fractional bits of the intermediate values in designEQFixed()
+static const int design_bits = 30;
+
+static inline int64_t designMul(int64_t a, int64_t b)
+{
+    return fix_mul_shift(a, b, design_bits);
+}
+
+// a / b for |a| < 2^37 (design values up to 128)
+static inline int64_t designDiv(int64_t a, int64_t b)
+{
+    return (a << (design_bits - 4)) / (b >> 4);
+}
+
+// beta = sqrt( (A*A + 1)/S - (A-1)*(A-1) ) of the shelving filters
+static int64_t shelfBeta(int64_t A, int64_t invS)
+{
+    const int64_t one = (int64_t) 1 << design_bits;
+
+    return fix_sqrt(designMul(designMul(A, A) + one, invS)
+                    - designMul(A - one, A - one), design_bits);
+}
+
+// Redesigns the filter from the design tables (see eq32_tables.h), no
+// floating point math on the coefficient path. Positions are table steps
+// with EQ32_TABLE_FRAC_BITS fractional bits and are interpolated linearly:
+//   f0   = fs/2 * 2^((freqPos - (EQ32_FREQ_STEPS-1)) / 12)
+//   gain = EQ32_GAIN_MIN_DB + gainPos / 2
+//   Q    = EQ32_Q_MIN * 2^(qPos / 6)
+void EQ32Base::designEQTable(int type, int32_t freqPos, int32_t gainPos, int32_t qPos)
+{
+    const int32_t *ft = &eq32FreqTable[0][0];
+    const int32_t *gt = &eq32GainTable[0][0];
+    const int32_t *qt = &eq32QTable[0][0];
+    int64_t cs, sn, A, sqrtA, sinhQ, invS, alpha, beta;
+
+    // all factors to design_bits
+    cs    = (int64_t) tableLookup(ft, EQ32_FREQ_COLS, EQ32_FREQ_COS, EQ32_FREQ_STEPS, freqPos)
+            << (design_bits - EQ32_FREQ_BITS);
+    sn    = (int64_t) tableLookup(ft, EQ32_FREQ_COLS, EQ32_FREQ_SIN, EQ32_FREQ_STEPS, freqPos)
+            << (design_bits - EQ32_FREQ_BITS);
+    A     = (int64_t) tableLookup(gt, EQ32_GAIN_COLS, EQ32_GAIN_A, EQ32_GAIN_STEPS, gainPos)
+            << (design_bits - EQ32_GAIN_BITS);
+    sqrtA = (int64_t) tableLookup(gt, EQ32_GAIN_COLS, EQ32_GAIN_SQRT_A, EQ32_GAIN_STEPS, gainPos)
+            << (design_bits - EQ32_GAIN_BITS);
+    sinhQ = (int64_t) tableLookup(qt, EQ32_Q_COLS, EQ32_Q_SINH, EQ32_Q_STEPS, qPos)
+            << (design_bits - EQ32_Q_BITS);
+    invS  = (int64_t) tableLookup(qt, EQ32_Q_COLS, EQ32_Q_INV_S, EQ32_Q_STEPS, qPos)
+            << (design_bits - EQ32_Q_BITS);
+
+    alpha = designMul(sn, sinhQ);
+    beta = 0;
+    if (type == LOW_SHELF_EQ || type == HIGH_SHELF_EQ)
+        beta = shelfBeta(A, invS);
+
+    // the parameters are kept as positions, paramsToDouble() converts
+    // them when they are asked for or changed one by one
+    this->type = type;
+    intParams[0] = freqPos;
+    intParams[1] = gainPos;
+    intParams[2] = qPos;
+    paramForm = PARAMS_TABLE;
+
+    designEQFixed(cs, sn, A, sqrtA, alpha, beta);
+}
+
+// f0, fs, gain and Q of the last designEQTable() or designEQInt(), once;
+// floating point, so it is left to the getters, the setters and designEQ()
+void EQ32Base::paramsToDouble(void)
+{
+    int32_t gainPos = intParams[1];
+
+    if (paramForm == PARAMS_INT)
+    {
+        f0 = intParams[0];
+        fs = intParams[1];
+        gain = intParams[2] / 100.;
+        Q = intParams[3] / 1000.;
+    }
+    else if (paramForm == PARAMS_TABLE)
+    {
+        f0 = fs * tableLookup(&eq32FreqTable[0][0], EQ32_FREQ_COLS, EQ32_FREQ_NORM,
+                              EQ32_FREQ_STEPS, intParams[0])
+                / double(1 << EQ32_FREQ_BITS);
+        if (gainPos < 0)
+            gainPos = 0;
+        if (gainPos > (EQ32_GAIN_STEPS - 1) << EQ32_TABLE_FRAC_BITS)
+            gainPos = (EQ32_GAIN_STEPS - 1) << EQ32_TABLE_FRAC_BITS;
+        gain = EQ32_GAIN_MIN_DB
+             + gainPos / double(EQ32_GAIN_STEPS_PER_DB << EQ32_TABLE_FRAC_BITS);
+        Q = tableLookup(&eq32QTable[0][0], EQ32_Q_COLS, EQ32_Q_VALUE, EQ32_Q_STEPS,
+                        intParams[2])
+            / double(1 << EQ32_Q_BITS);
+    }
+    paramForm = PARAMS_DOUBLE;
+}
+
+// Design from integer parameters: f0 and fs in Hz, gain in 0.01 dB, Q in
+// 0.001, limited like the setters. With EQ32_FIXED_DESIGN this path has
+// no floating point operation at all; the doubles are only made when
+// they are asked for, see paramsToDouble().
+void EQ32Base::designEQInt(int type, int32_t f0Hz, int32_t fsHz, int32_t gainCdB,
+                           int32_t qMilli)
+{
+    if (f0Hz < 0)
+        f0Hz = 0;
+    if (f0Hz > fsHz/2)
+        f0Hz = fsHz/2;
+    if (gainCdB < -2400)
+        gainCdB = -2400;
+    if (gainCdB > 2400)
+        gainCdB = 2400;
+    if (qMilli < 100)
+        qMilli = 100;
+    if (qMilli > 30000)
+        qMilli = 30000;
+
+    this->type = type;
+    intParams[0] = f0Hz;
+    intParams[1] = fsHz;
+    intParams[2] = gainCdB;
+    intParams[3] = qMilli;
+    paramForm = PARAMS_INT;
+
+#if EQ32_FIXED_DESIGN
+    // phase f0/fs * 2^32, gain in Q8.24, Q in Q2.30
+    designEQFixedParams((uint32_t) (((uint64_t) f0Hz << 32) / (uint32_t) fsHz),
+                        (int64_t) gainCdB * fixed_one / 100,
+                        ((int64_t) qMilli << design_bits) / 1000);
+#else
+    designEQ();
+#endif
+}
+
+double EQ32Base::getCenterFrequency(void)
+{
+    paramsToDouble();
+    return f0;
+}
+
+double EQ32Base::getGain(void)
+{
+    paramsToDouble();
+    return gain;
+}
+
+double EQ32Base::getQfactor(void)
+{
+    paramsToDouble();
+    return Q;
+}
+
+#if EQ32_FIXED_DESIGN
+// designEQ() without floating point library calls, the parameters are
+// converted to fixed point once and the cookbook factors are evaluated
+// with fixmath. For 20 Hz .. 20 kHz, Q >= 0.5 and +-24 dB the
+// coefficients are within 8 LSB of the floating point version.
+void EQ32Base::designEQ(void)
+{
+    const int64_t one = (int64_t) 1 << design_bits;
+
+    paramsToDouble();
+    if (Q < 0.1) Q = 0.1;
+
+    // the double parameters to fixed point, the only floating point
+    // operations left; designEQInt() does without them
+    designEQFixedParams((uint32_t) (int64_t) (f0 / fs * 4294967296.),
+                        (int64_t) ((gain < -96 ? -96 : gain > 96 ? 96 : gain) * fixed_one),
+                        (int64_t) ((Q > 100 ? 100 : Q) * (double) one));
+}
+
+// phase = f0/fs * 2^32, gain in Q8.24, Q in Q2.30 (64 bit)
+void EQ32Base::designEQFixedParams(uint32_t phase, int64_t gainFix, int64_t Qfix)
+{
+    const int64_t one = (int64_t) 1 << design_bits;
+    const int64_t log2_10_div_40 = 89172328;    // log2(10)/40 in Q2.30
+    const int64_t log2_e = 1549082005;          // log2(e) in Q2.30
+    int32_t sn32, cs32;
+    int64_t exponent, yLog2e;
+    int64_t cs, sn, A, sqrtA, sinhQ, invS, alpha, beta;
+
+    sn32 = fix_sincos(phase, &cs32);
+
+    // fixmath results are in Q2.30, the design format
+    cs = cs32;
+    sn = sn32;
+
+    // A = 10^(gain/40) = 2^(gain * log2(10)/40)
+    exponent = (gainFix * log2_10_div_40) >> fractional_bits;
+    A = fix_exp2(exponent, design_bits);
+    sqrtA = fix_exp2(exponent / 2, design_bits);
+
+    // sinh(y) = (e^y - e^-y)/2, y = 1/(2Q)
+    yLog2e = designMul(((int64_t) 1 << (2*design_bits - 1)) / Qfix, log2_e);
+    sinhQ = (fix_exp2(yLog2e, design_bits) - fix_exp2(-yLog2e, design_bits)) / 2;
+    alpha = designMul(sn, sinhQ);
+
+    // 1/S, S = min(Q, 1)
+    invS = Qfix < one ? ((int64_t) 1 << (2*design_bits)) / Qfix : one;
+
+    beta = 0;
+    if (type == LOW_SHELF_EQ || type == HIGH_SHELF_EQ)
+        beta = shelfBeta(A, invS);
+
+    designEQFixed(cs, sn, A, sqrtA, alpha, beta);
+}
+#endif
+
+// cookbook formulae in fixed point, arguments as in designEQ() with
+// design_bits fractional bits
+void EQ32Base::designEQFixed(int64_t cs, int64_t sn, int64_t A, int64_t sqrtA,
+                             int64_t alpha, int64_t beta)
+{
+    const int64_t one = (int64_t) 1 << design_bits;
+    int64_t b0, b1, b2, a0, a1, a2;
+    int64_t Ap1 = A + one, Am1 = A - one;
+    int64_t Am1cs = designMul(Am1, cs), Ap1cs = designMul(Ap1, cs);
+    int64_t betasn = designMul(beta, sn), sqrtAalpha2 = 2*designMul(sqrtA, alpha);
+
+    switch (type)
+    {
+    case GAIN_EQ:
+        b0 = designMul(A, A);
+        b1 = 0;
+        b2 = 0;
+        a0 = one;
+        a1 = 0;
+        a2 = 0;
+        break;
+
+    case LOW_PASS_EQ:
+        b0 = (one - cs)/2;
+        b1 =  one - cs;
+        b2 = (one - cs)/2;
+        a0 =  one + alpha;
+        a1 = -2*cs;
+        a2 =  one - alpha;
+        break;
+
+    case HIGH_PASS_EQ:
+        b0 = (one + cs)/2;
+        b1 = -one - cs;
+        b2 = (one + cs)/2;
+        a0 =  one + alpha;
+        a1 = -2*cs;
+        a2 =  one - alpha;
+        break;
+
+    case BAND_PASS_EQ:
+        b0 =  alpha;
+        b1 =  0;
+        b2 = -alpha;
+        a0 =  one + alpha;
+        a1 = -2*cs;
+        a2 =  one - alpha;
+        break;
+
+    case NOTCH_EQ:
+        b0 =  one;
+        b1 = -2*cs;
+        b2 =  one;
+        a0 =  one + alpha;
+        a1 = -2*cs;
+        a2 =  one - alpha;
+        break;
+
+    case PEAKING_EQ:
+        b0 =  one + designMul(alpha, A);
+        b1 = -2*cs;
+        b2 =  one - designMul(alpha, A);
+        a0 =  one + designDiv(alpha, A);
+        a1 = -2*cs;
+        a2 =  one - designDiv(alpha, A);
+        break;
+
+    case LOW_SHELF_EQ:
+        b0 =    designMul(A, Ap1 - Am1cs + betasn);
+        b1 =  2*designMul(A, Am1 - Ap1cs);
+        b2 =    designMul(A, Ap1 - Am1cs - betasn);
+        a0 =        Ap1 + Am1cs + betasn;
+        a1 =   -2*( Am1 + Ap1cs );
+        a2 =        Ap1 + Am1cs - betasn;
+        break;
+
+    case HIGH_SHELF_EQ:
+        b0 =    designMul(A, Ap1 + Am1cs + betasn);
+        b1 = -2*designMul(A, Am1 + Ap1cs);
+        b2 =    designMul(A, Ap1 + Am1cs - betasn);
+        a0 =        Ap1 - Am1cs + betasn;
+        a1 =    2*( Am1 - Ap1cs );
+        a2 =        Ap1 - Am1cs - betasn;
+        break;
+
+    case LOW_SHELFQ_EQ:
+        b0 =    designMul(A, Ap1 - Am1cs + sqrtAalpha2);
+        b1 =  2*designMul(A, Am1 - Ap1cs);
+        b2 =    designMul(A, Ap1 - Am1cs - sqrtAalpha2);
+        a0 =        Ap1 + Am1cs + sqrtAalpha2;
+        a1 =   -2*( Am1 + Ap1cs );
+        a2 =        Ap1 + Am1cs - sqrtAalpha2;
+        break;
+
+    case HIGH_SHELFQ_EQ:
+        b0 =    designMul(A, Ap1 + Am1cs + sqrtAalpha2);
+        b1 = -2*designMul(A, Am1 + Ap1cs);
+        b2 =    designMul(A, Ap1 + Am1cs - sqrtAalpha2);
+        a0 =        Ap1 - Am1cs + sqrtAalpha2;
+        a1 =    2*( Am1 - Ap1cs );
+        a2 =        Ap1 - Am1cs - sqrtAalpha2;
+        break;
+
+    case ALLPASS_EQ:
+        b0 =  one - alpha;
+        b1 = -2*cs;
+        b2 =  one + alpha;
+        a0 =  one + alpha;
+        a1 = -2*cs;
+        a2 =  one - alpha;
+        break;
+
+    default:
+        b0 = one;
+        b1 = 0;
+        b2 = 0;
+        a0 = one;
+        a1 = 0;
+        a2 = 0;
+        break;
+    }
+
+    // scale down very large terms (extreme Q) to keep b * fixed_one in range,
+    // the ratios are unchanged
+    int64_t maxTerm = 0, terms[6] = { b0, b1, b2, a0, a1, a2 };
+    for (int i=0; i<6; i++)
+    {
+        int64_t t = terms[i] < 0 ? -terms[i] : terms[i];
+        if (t > maxTerm)
+            maxTerm = t;
+    }
+    while (maxTerm >= (int64_t) 1 << (62 - fractional_bits))
+    {
+        b0 >>= 1; b1 >>= 1; b2 >>= 1;
+        a0 >>= 1; a1 >>= 1; a2 >>= 1;
+        maxTerm >>= 1;
+    }
+
+    // one division per coefficient to integer_bits.fractional_bits,
+    // truncated like setCoefficients()
+    newCoefficients[0] = (int32_t) ( b0*fixed_one / a0);
+    newCoefficients[1] = (int32_t) ( b1*fixed_one / a0);
+    newCoefficients[2] = (int32_t) ( b2*fixed_one / a0);
+    newCoefficients[3] = (int32_t) (-a1*fixed_one / a0);
+    newCoefficients[4] = (int32_t) (-a2*fixed_one / a0);
+    update_filter = true;
+}
 
-void EQ32::setCoefficients(double double_coeffs[])
+void EQ32Base::setCoefficients(double double_coeffs[])
 {
     for (int i=0; i<BIQUAD_COEFFS; i++)
         newCoefficients[i] = int32_t(double_coeffs[i] * fixed_one);
     update_filter = true;
 }
 
-void EQ32::getNewCoefficients(double float_coefficients[])
+// 0 switches coefficients in one step, otherwise new coefficients are
+// approached linearly over the given number of samples (in block steps)
+void EQ32Base::setRampLength(int32_t samples)
+{
+    if (samples < 0)
+        samples = 0;
+
+    rampLength = samples;
+}
+
+void EQ32Base::startRamp(void)
+{
+    startBiquadRamp(coefficients, newCoefficients, rampLength, rampStep);
+    rampRemaining = rampLength;
+    kind = BIQUAD_FULL;                     // coefficients in between
+}
+
+void EQ32Base::stepRamp(int32_t frames)
+{
+    if (frames >= rampRemaining)
+    {
+        for (int i=0; i<BIQUAD_COEFFS; i++)
+            coefficients[i] = newCoefficients[i];
+        kind = classifyBiquad(coefficients);
+        rampRemaining = 0;
+        return;
+    }
+
+    stepBiquadRamp(coefficients, rampStep, frames);
+    rampRemaining -= frames;
+}
+
+void EQ32Base::getNewCoefficients(double float_coefficients[])
 {
     for (int i=0; i<BIQUAD_COEFFS; i++)
         float_coefficients[i] = newCoefficients[i] / double(fixed_one);
 }
 
-void EQ32::getCoefficients(double float_coefficients[])
+void EQ32Base::getNewCoefficients(int32_t fixed_coefficients[])
+{
+    for (int i=0; i<BIQUAD_COEFFS; i++)
+        fixed_coefficients[i] = newCoefficients[i];
+}
+
+void EQ32Base::getCoefficients(double float_coefficients[])
 {
     for (int i=0; i<BIQUAD_COEFFS; i++)
         float_coefficients[i] = coefficients[i] / double(fixed_one);
@@ -28,7 +28,17 @@ extern "C" {
 #define EQ_CHANS 2
 #endif
 
+#ifndef ERROR_FEEDBACK
+#define ERROR_FEEDBACK 0
+#endif
+
+// 1: designEQ() uses fixed-point math only (fixmath.h), no libm
+#ifndef EQ32_FIXED_DESIGN
+#define EQ32_FIXED_DESIGN 0
+#endif
+
 #include <stdint.h>
+#include <stddef.h>
 
 enum {
     GAIN_EQ,
@@ -59,38 +69,243 @@ const int32_t fixed_one = 1 << fractional_bits;
 // mask for error feedback
 const int32_t error_mask = 0xffffffff >> integer_bits;
 
+// kernel of a stage, chosen from its coefficients when they are taken over
+enum {
+    BIQUAD_BYPASS,                          // y = x, the stage is skipped
+    BIQUAD_GAIN,                            // y = b0 * x
+    BIQUAD_FIRST_ORDER,                     // b2 = a2 = 0
+    BIQUAD_FULL
+};
+
 #if ( ! __ADSPBLACKFIN__ )
 #define expected_true
 #define expected_false
 #endif
 
-class EQ32
+}
+
+// Zeros equal to the poles (b0 = 1, b1 = a1, b2 = a2) are a bypass, e.g.
+// peaking and shelving filters at 0 dB: once the output history equals
+// the input history the full kernel returns x exactly. This holds in the
+// steady state only: a stage that becomes a bypass stops at once, where
+// the full kernel would still ring out the previous response, and it
+// drops the small DC offset of the kernel's truncation.
+inline int classifyBiquad(const int32_t c[BIQUAD_COEFFS])
+{
+    if (c[0] == fixed_one && c[1] == -c[3] && c[2] == -c[4])
+        return BIQUAD_BYPASS;
+
+    if (c[1] == 0 && c[2] == 0 && c[3] == 0 && c[4] == 0)
+        return BIQUAD_GAIN;
+
+    if (c[2] == 0 && c[4] == 0)
+        return BIQUAD_FIRST_ORDER;
+
+    return BIQUAD_FULL;
+}
+
+// The direct form is stable inside the triangle |a2| < 1, |a1| < 1 + a2.
+// It is convex, so the line between two stable coefficient sets stays
+// inside, but truncated ramp steps drift off the line by up to one LSB
+// per step and can cross the edge for poles close to z = 1 (low corner
+// frequencies). Pulls -a1 = c[3], -a2 = c[4] back to one LSB inside.
+inline void clampBiquadFeedback(int32_t c[BIQUAD_COEFFS])
+{
+    const int32_t edge = fixed_one - 1;
+
+    if (c[4] > edge)
+        c[4] = edge;
+    if (c[4] < -edge)
+        c[4] = -edge;
+
+    // |a1| <= 1 + a2 - LSB
+    int32_t a1Max = edge - c[4];
+
+    if (c[3] > a1Max)
+        c[3] = a1Max;
+    if (c[3] < -a1Max)
+        c[3] = -a1Max;
+}
+
+// change per sample of each coefficient for a linear ramp from -> to
+inline void startBiquadRamp(const int32_t from[BIQUAD_COEFFS], const int32_t to[BIQUAD_COEFFS],
+                            int32_t length, int32_t step[BIQUAD_COEFFS])
+{
+    for (int i=0; i<BIQUAD_COEFFS; i++)
+        step[i] = (to[i] - from[i]) / length;
+}
+
+// frames samples further along the ramp, the end point is copied by the
+// caller so that it is reached exactly
+inline void stepBiquadRamp(int32_t c[BIQUAD_COEFFS], const int32_t step[BIQUAD_COEFFS],
+                           int32_t frames)
+{
+    for (int i=0; i<BIQUAD_COEFFS; i++)
+        c[i] += step[i] * frames;
+    clampBiquadFeedback(c);
+}
+
+// one sample of one channel through a stage of the given kind, same
+// result and states as the full biquad: bypass and gain stages skip the
+// multiplies but still shift the history, so that the stage continues
+// without a click when it becomes a full filter again (the error state
+// of the full kernel is unchanged by a bypass)
+template <bool ErrorFeedback>
+inline int32_t biquadSample(const int32_t c[BIQUAD_COEFFS], int32_t st[BIQUAD_STATES],
+                            int32_t x, int kind)
+{
+    int64_t temp64;
+
+    switch (kind)
+    {
+    case BIQUAD_BYPASS:
+        st[1] = st[0];
+        st[0] = x;
+        st[3] = st[2];
+        st[2] = x;
+        return x;
+
+    case BIQUAD_GAIN:
+        temp64 = (int64_t) c[0] * x;
+        break;
+
+    case BIQUAD_FIRST_ORDER:
+        temp64 =  (int64_t) c[0] * x;
+        temp64 += (int64_t) c[1] * st[0];
+        temp64 += (int64_t) c[3] * st[2];
+        break;
+
+    default:
+        temp64 =  (int64_t) c[0] * x;
+        temp64 += (int64_t) c[1] * st[0];
+        temp64 += (int64_t) c[2] * st[1];
+        temp64 += (int64_t) c[3] * st[2];
+        temp64 += (int64_t) c[4] * st[3];
+        break;
+    }
+
+    if (ErrorFeedback)
+    {
+        temp64 += st[4];
+        st[4] = (int32_t) (temp64 & error_mask);
+    }
+    st[1] = st[0];
+    st[0] = x;
+    x = (int32_t) (temp64 >> fractional_bits);
+    st[3] = st[2];
+    st[2] = x;
+    return x;
+}
+
+// channel independent part: parameters, design and coefficients
+class EQ32Base
 {
 protected:
+    // f0, fs, gain and Q are valid (double), or still intParams from
+    // designEQTable() (positions) or designEQInt() (Hz, 0.01 dB, 0.001)
+    enum { PARAMS_DOUBLE, PARAMS_TABLE, PARAMS_INT };
+
     int type;                               // filter type
     double f0;                              // center/corner frequency (Hz)
     double fs;                              // sampling frequency (Hz)
     double gain;                            // gain (dB)
     double Q;                               // quality factor
     bool   update_filter;                   // flag for coefficient update
+    int    paramForm;                       // where the current parameters are
+    int32_t intParams[4];                   // see paramsToDouble()
+    int    kind;                            // kernel for coefficients
     int32_t coefficients[BIQUAD_COEFFS];    // filter coefficients
     int32_t newCoefficients[BIQUAD_COEFFS]; // new filter coefficients
-    int32_t states[EQ_CHANS][BIQUAD_STATES];// filter states
+    int32_t rampLength;                     // coefficient ramp (samples)
+    int32_t rampRemaining;                  // samples left in the ramp
+    int32_t rampStep[BIQUAD_COEFFS];        // coefficient change per sample
+
+    void startRamp(void);
+    void stepRamp(int32_t frames);
+    void paramsToDouble(void);
+#if EQ32_FIXED_DESIGN
+    void designEQFixedParams(uint32_t phase, int64_t gainFix, int64_t Qfix);
+#endif
+    void designEQFixed(int64_t cs, int64_t sn, int64_t A, int64_t sqrtA,
+                       int64_t alpha, int64_t beta);
+
+    // called once per block before the coefficients are read
+    inline void updateCoefficients(size_t frames)
+    {
+        // copy new coefficients if available, once per update
+        if (expected_false(update_filter))
+        {
+            if (rampLength > 0)
+                startRamp();
+            else
+            {
+                for (int i=0; i<BIQUAD_COEFFS; i++)
+                    coefficients[i] = newCoefficients[i];
+                kind = classifyBiquad(coefficients);
+            }
+            update_filter = false;
+        }
+
+        if (expected_false(rampRemaining > 0))
+            stepRamp((int32_t) frames);
+    }
 
 public:
-    EQ32(void);
-    EQ32(int type, double f0, double fs, double gain, double Q);
-    ~EQ32(void);
+    EQ32Base(void);
+    EQ32Base(int type, double f0, double fs, double gain, double Q);
+    ~EQ32Base(void);
     void setType(int type, int update_coeffs = 1);
     void setCenterFrequency(double f0, int update_coeffs = 1);
     void setSamplingFrequency(double fs, int update_coeffs = 1);
     void setGain(double gain, int update_coeffs = 1);
     void setQfactor(double Q, int update_coeffs = 1);
     void setCoefficients(double double_coeffs[]);
+    void setRampLength(int32_t samples);
     void getNewCoefficients(double float_coefficients[]);
+    void getNewCoefficients(int32_t fixed_coefficients[]);
     void getCoefficients(double float_coefficients[]);
-    void resetStates(void);
+    int getKind(void) const { return kind; }
+    int getType(void) const { return type; }
+    double getCenterFrequency(void);
+    double getGain(void);
+    double getQfactor(void);
     void designEQ(void);
+    void designEQInt(int type, int32_t f0Hz, int32_t fsHz, int32_t gainCdB, int32_t qMilli);
+    void designEQTable(int type, int32_t freqPos, int32_t gainPos, int32_t qPos);
+};
+
+// positions for designEQTable() found in the design tables, integer math
+// only: f0 and fs in Hz, gain in 0.01 dB, Q in 0.001
+int32_t eq32FreqPos(int32_t f0Hz, int32_t fsHz);
+int32_t eq32GainPos(int32_t gainCdB);
+int32_t eq32QPos(int32_t qMilli);
+
+// NumChans and ErrorFeedback are compile-time constants, so the channel
+// loops unroll and the error feedback path vanishes when it is disabled
+template <int NumChans, bool ErrorFeedback = (ERROR_FEEDBACK != 0)>
+class EQ32N : public EQ32Base
+{
+protected:
+    int32_t states[NumChans][BIQUAD_STATES];// filter states
+
+public:
+    EQ32N(void) : EQ32Base()
+    {
+        resetStates();
+    }
+
+    EQ32N(int type, double f0, double fs, double gain, double Q)
+        : EQ32Base(type, f0, fs, gain, Q)
+    {
+        resetStates();
+    }
+
+    void resetStates(void)
+    {
+        for (int i=0; i<NumChans; i++)
+            for (int j=0; j<BIQUAD_STATES; j++)
+                states[i][j] = 0;
+    }
 
     inline void process(int32_t samples[])
     {
@@ -98,12 +313,17 @@ public:
         // format : integer_bits.fractional_bits
         int64_t temp64;
 
-        // copy new coefficients if available
-        if (expected_false(update_filter))
-            for (int i=0; i<BIQUAD_COEFFS; i++)
-                coefficients[i] = newCoefficients[i];
+        updateCoefficients(1);
 
-        for (int i=0; i<EQ_CHANS; i++)
+        if (kind != BIQUAD_FULL)
+        {
+            for (int i=0; i<NumChans; i++)
+                samples[i] = biquadSample<ErrorFeedback>(coefficients, states[i],
+                                                         samples[i], kind);
+            return;
+        }
+
+        for (int i=0; i<NumChans; i++)
         {
             // biquad filter
             temp64 =  (int64_t) coefficients[0] * samples[i];
@@ -111,10 +331,11 @@ public:
             temp64 += (int64_t) coefficients[2] * states[i][1];
             temp64 += (int64_t) coefficients[3] * states[i][2];
             temp64 += (int64_t) coefficients[4] * states[i][3];
-#if (ERROR_FEEDBACK)
-            // error feedback
-            temp64 += states[i][4];
-#endif
+            if (ErrorFeedback)
+            {
+                // error feedback
+                temp64 += states[i][4];
+            }
             // update of non-recursive states
             states[i][1] = states[i][0];
             states[i][0] = samples[i];
@@ -125,14 +346,196 @@ public:
             // update of recursive states
             states[i][3] = states[i][2];
             states[i][2] = samples[i];
-#if (ERROR_FEEDBACK)
-            // update of quantization error
-            states[i][4] = (int32_t) (temp64 & error_mask);
-#endif
+            if (ErrorFeedback)
+            {
+                // update of quantization error
+                states[i][4] = (int32_t) (temp64 & error_mask);
+            }
+        }
+    }
+
+    // interleaved block: samples[frame * NumChans + channel]
+    inline void processBlock(int32_t *interleaved, size_t frames)
+    {
+        int32_t *channels[NumChans];
+
+        for (int i=0; i<NumChans; i++)
+            channels[i] = interleaved + i;
+
+        processBlockStrided(channels, NumChans, frames);
+    }
+
+    // planar block: channels[channel][frame]
+    inline void processBlockPlanar(int32_t *channels[], size_t frames)
+    {
+        processBlockStrided(channels, 1, frames);
+    }
+
+protected:
+    inline void processBlockStrided(int32_t *channels[], size_t stride, size_t frames)
+    {
+        // coefficient updates and ramps advance at block boundaries only
+        updateCoefficients(frames);
+
+        if (kind == BIQUAD_BYPASS)
+        {
+            bypassHistory(channels, stride, frames);
+            return;
+        }
+
+        if (kind == BIQUAD_GAIN)
+        {
+            processGainStrided(channels, stride, frames);
+            return;
+        }
+
+        if (kind == BIQUAD_FIRST_ORDER)
+        {
+            processFirstOrderStrided(channels, stride, frames);
+            return;
+        }
+
+        const int32_t b0 = coefficients[0];
+        const int32_t b1 = coefficients[1];
+        const int32_t b2 = coefficients[2];
+        const int32_t a1 = coefficients[3];
+        const int32_t a2 = coefficients[4];
+
+        for (int i=0; i<NumChans; i++)
+        {
+            int32_t x1 = states[i][0];
+            int32_t x2 = states[i][1];
+            int32_t y1 = states[i][2];
+            int32_t y2 = states[i][3];
+            int32_t err = states[i][4];
+            int32_t *p = channels[i];
+
+            for (size_t n=0; n<frames; n++, p+=stride)
+            {
+                int64_t temp64;
+                temp64 =  (int64_t) b0 * *p;
+                temp64 += (int64_t) b1 * x1;
+                temp64 += (int64_t) b2 * x2;
+                temp64 += (int64_t) a1 * y1;
+                temp64 += (int64_t) a2 * y2;
+                if (ErrorFeedback)
+                {
+                    temp64 += err;
+                    err = (int32_t) (temp64 & error_mask);
+                }
+                x2 = x1;
+                x1 = *p;
+                y2 = y1;
+                y1 = (int32_t) (temp64 >> fractional_bits);
+                *p = y1;
+            }
+
+            states[i][0] = x1;
+            states[i][1] = x2;
+            states[i][2] = y1;
+            states[i][3] = y2;
+            states[i][4] = err;
+        }
+    }
+
+    // the output equals the input, only the last two samples of the
+    // block are kept as history
+    inline void bypassHistory(int32_t *channels[], size_t stride, size_t frames)
+    {
+        if (frames == 0)
+            return;
+
+        for (int i=0; i<NumChans; i++)
+        {
+            const int32_t *last = channels[i] + (frames - 1) * stride;
+
+            states[i][1] = frames > 1 ? last[-(ptrdiff_t) stride] : states[i][0];
+            states[i][0] = last[0];
+            states[i][2] = states[i][0];
+            states[i][3] = states[i][1];
+        }
+    }
+
+    inline void processGainStrided(int32_t *channels[], size_t stride, size_t frames)
+    {
+        const int32_t b0 = coefficients[0];
+
+        for (int i=0; i<NumChans; i++)
+        {
+            int32_t x1 = states[i][0];
+            int32_t x2 = states[i][1];
+            int32_t y1 = states[i][2];
+            int32_t y2 = states[i][3];
+            int32_t err = states[i][4];
+            int32_t *p = channels[i];
+
+            for (size_t n=0; n<frames; n++, p+=stride)
+            {
+                int64_t temp64 = (int64_t) b0 * *p;
+                if (ErrorFeedback)
+                {
+                    temp64 += err;
+                    err = (int32_t) (temp64 & error_mask);
+                }
+                x2 = x1;
+                x1 = *p;
+                y2 = y1;
+                y1 = (int32_t) (temp64 >> fractional_bits);
+                *p = y1;
+            }
+
+            states[i][0] = x1;
+            states[i][1] = x2;
+            states[i][2] = y1;
+            states[i][3] = y2;
+            states[i][4] = err;
+        }
+    }
+
+    // b2 = a2 = 0, the second states are still shifted for a later switch
+    inline void processFirstOrderStrided(int32_t *channels[], size_t stride, size_t frames)
+    {
+        const int32_t b0 = coefficients[0];
+        const int32_t b1 = coefficients[1];
+        const int32_t a1 = coefficients[3];
+
+        for (int i=0; i<NumChans; i++)
+        {
+            int32_t x1 = states[i][0];
+            int32_t x2 = states[i][1];
+            int32_t y1 = states[i][2];
+            int32_t y2 = states[i][3];
+            int32_t err = states[i][4];
+            int32_t *p = channels[i];
+
+            for (size_t n=0; n<frames; n++, p+=stride)
+            {
+                int64_t temp64;
+                temp64 =  (int64_t) b0 * *p;
+                temp64 += (int64_t) b1 * x1;
+                temp64 += (int64_t) a1 * y1;
+                if (ErrorFeedback)
+                {
+                    temp64 += err;
+                    err = (int32_t) (temp64 & error_mask);
+                }
+                x2 = x1;
+                x1 = *p;
+                y2 = y1;
+                y1 = (int32_t) (temp64 >> fractional_bits);
+                *p = y1;
+            }
+
+            states[i][0] = x1;
+            states[i][1] = x2;
+            states[i][2] = y1;
+            states[i][3] = y2;
+            states[i][4] = err;
         }
     }
 };
 
-}
+// macro configured default instantiation
+typedef EQ32N<EQ_CHANS> EQ32;
 
 #endif  // _EQ32
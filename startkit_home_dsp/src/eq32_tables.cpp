@@ -0,0 +1,294 @@
+/*---------------------------------------------------------------------------*\
+|   EQ32 design tables, generated by host/gen_eq32_tables.cpp - do not edit   |
+\*---------------------------------------------------------------------------*/
+
+#include "eq32_tables.h"
+
+const int32_t eq32FreqTable[EQ32_FREQ_STEPS][EQ32_FREQ_COLS] = {
+    {      262144,  1073740561,     1647099 },  //     11.7 Hz at 48 kHz
+    {      277732,  1073740406,     1745040 },  //     12.4 Hz at 48 kHz
+    {      294247,  1073740232,     1848806 },  //     13.2 Hz at 48 kHz
+    {      311744,  1073740037,     1958741 },  //     13.9 Hz at 48 kHz
+    {      330281,  1073739819,     2075214 },  //     14.8 Hz at 48 kHz
+    {      349920,  1073739573,     2198612 },  //     15.6 Hz at 48 kHz
+    {      370728,  1073739297,     2329348 },  //     16.6 Hz at 48 kHz
+    {      392772,  1073738988,     2467858 },  //     17.6 Hz at 48 kHz
+    {      416128,  1073738641,     2614605 },  //     18.6 Hz at 48 kHz
+    {      440872,  1073738251,     2770077 },  //     19.7 Hz at 48 kHz
+    {      467088,  1073737813,     2934794 },  //     20.9 Hz at 48 kHz
+    {      494862,  1073737322,     3109305 },  //     22.1 Hz at 48 kHz
+    {      524288,  1073736771,     3294193 },  //     23.4 Hz at 48 kHz
+    {      555464,  1073736152,     3490076 },  //     24.8 Hz at 48 kHz
+    {      588493,  1073735457,     3697606 },  //     26.3 Hz at 48 kHz
+    {      623487,  1073734678,     3917476 },  //     27.9 Hz at 48 kHz
+    {      660561,  1073733802,     4150420 },  //     29.5 Hz at 48 kHz
+    {      699841,  1073732820,     4397215 },  //     31.3 Hz at 48 kHz
+    {      741455,  1073731718,     4658686 },  //     33.1 Hz at 48 kHz
+    {      785544,  1073730480,     4935704 },  //     35.1 Hz at 48 kHz
+    {      832255,  1073729091,     5229194 },  //     37.2 Hz at 48 kHz
+    {      881744,  1073727531,     5540135 },  //     39.4 Hz at 48 kHz
+    {      934175,  1073725781,     5869565 },  //     41.8 Hz at 48 kHz
+    {      989724,  1073723816,     6218584 },  //     44.2 Hz at 48 kHz
+    {     1048576,  1073721611,     6588356 },  //     46.9 Hz at 48 kHz
+    {     1110928,  1073719136,     6980115 },  //     49.7 Hz at 48 kHz
+    {     1176987,  1073716357,     7395167 },  //     52.6 Hz at 48 kHz
+    {     1246974,  1073713239,     7834899 },  //     55.7 Hz at 48 kHz
+    {     1321123,  1073709738,     8300778 },  //     59.1 Hz at 48 kHz
+    {     1399681,  1073705809,     8794357 },  //     62.6 Hz at 48 kHz
+    {     1482910,  1073701398,     9317284 },  //     66.3 Hz at 48 kHz
+    {     1571089,  1073696448,     9871303 },  //     70.2 Hz at 48 kHz
+    {     1664511,  1073690891,    10458263 },  //     74.4 Hz at 48 kHz
+    {     1763488,  1073684654,    11080123 },  //     78.8 Hz at 48 kHz
+    {     1868350,  1073677653,    11738956 },  //     83.5 Hz at 48 kHz
+    {     1979448,  1073669794,    12436960 },  //     88.5 Hz at 48 kHz
+    {     2097152,  1073660973,    13176464 },  //     93.8 Hz at 48 kHz
+    {     2221855,  1073651072,    13959934 },  //     99.3 Hz at 48 kHz
+    {     2353974,  1073639959,    14789984 },  //    105.2 Hz at 48 kHz
+    {     2493948,  1073627484,    15669382 },  //    111.5 Hz at 48 kHz
+    {     2642246,  1073613482,    16601059 },  //    118.1 Hz at 48 kHz
+    {     2799362,  1073597766,    17588124 },  //    125.1 Hz at 48 kHz
+    {     2965821,  1073580124,    18633866 },  //    132.6 Hz at 48 kHz
+    {     3142178,  1073560323,    19741772 },  //    140.5 Hz at 48 kHz
+    {     3329021,  1073538097,    20915535 },  //    148.8 Hz at 48 kHz
+    {     3526975,  1073513149,    22159066 },  //    157.7 Hz at 48 kHz
+    {     3736700,  1073485146,    23476508 },  //    167.0 Hz at 48 kHz
+    {     3958896,  1073453714,    24872251 },  //    177.0 Hz at 48 kHz
+    {     4194304,  1073418433,    26350943 },  //    187.5 Hz at 48 kHz
+    {     4443710,  1073378832,    27917509 },  //    198.6 Hz at 48 kHz
+    {     4707947,  1073334382,    29577162 },  //    210.5 Hz at 48 kHz
+    {     4987896,  1073284490,    31335426 },  //    223.0 Hz at 48 kHz
+    {     5284492,  1073228488,    33198150 },  //    236.2 Hz at 48 kHz
+    {     5598724,  1073165629,    35171529 },  //    250.3 Hz at 48 kHz
+    {     5931642,  1073095075,    37262120 },  //    265.2 Hz at 48 kHz
+    {     6284355,  1073015881,    39476870 },  //    280.9 Hz at 48 kHz
+    {     6658043,  1072926992,    41823133 },  //    297.6 Hz at 48 kHz
+    {     7053950,  1072827220,    44308693 },  //    315.3 Hz at 48 kHz
+    {     7473400,  1072715234,    46941792 },  //    334.1 Hz at 48 kHz
+    {     7917792,  1072589538,    49731155 },  //    354.0 Hz at 48 kHz
+    {     8388608,  1072448455,    52686014 },  //    375.0 Hz at 48 kHz
+    {     8887421,  1072290102,    55816142 },  //    397.3 Hz at 48 kHz
+    {     9415894,  1072112366,    59131878 },  //    420.9 Hz at 48 kHz
+    {     9975792,  1071912876,    62644159 },  //    446.0 Hz at 48 kHz
+    {    10568984,  1071688971,    66364558 },  //    472.5 Hz at 48 kHz
+    {    11197448,  1071437664,    70305310 },  //    500.6 Hz at 48 kHz
+    {    11863283,  1071155605,    74479352 },  //    530.3 Hz at 48 kHz
+    {    12568711,  1070839034,    78900361 },  //    561.9 Hz at 48 kHz
+    {    13316085,  1070483733,    83582789 },  //    595.3 Hz at 48 kHz
+    {    14107901,  1070084967,    88541902 },  //    630.7 Hz at 48 kHz
+    {    14946800,  1069637426,    93793823 },  //    668.2 Hz at 48 kHz
+    {    15835583,  1069135153,    99355571 },  //    707.9 Hz at 48 kHz
+    {    16777216,  1068571464,   105245103 },  //    750.0 Hz at 48 kHz
+    {    17774841,  1067938862,   111481355 },  //    794.6 Hz at 48 kHz
+    {    18831788,  1067228938,   118084284 },  //    841.8 Hz at 48 kHz
+    {    19951585,  1066432263,   125074910 },  //    891.9 Hz at 48 kHz
+    {    21137968,  1065538261,   132475355 },  //    944.9 Hz at 48 kHz
+    {    22394897,  1064535073,   140308880 },  //   1001.1 Hz at 48 kHz
+    {    23726566,  1063409408,   148599921 },  //   1060.7 Hz at 48 kHz
+    {    25137421,  1062146361,   157374118 },  //   1123.7 Hz at 48 kHz
+    {    26632170,  1060729231,   166658341 },  //   1190.6 Hz at 48 kHz
+    {    28215802,  1059139304,   176480707 },  //   1261.3 Hz at 48 kHz
+    {    29893600,  1057355611,   186870589 },  //   1336.3 Hz at 48 kHz
+    {    31671166,  1055354667,   197858613 },  //   1415.8 Hz at 48 kHz
+    {    33554432,  1053110176,   209476638 },  //   1500.0 Hz at 48 kHz
+    {    35549682,  1050592698,   221757723 },  //   1589.2 Hz at 48 kHz
+    {    37663576,  1047769290,   234736064 },  //   1683.7 Hz at 48 kHz
+    {    39903169,  1044603100,   248446910 },  //   1783.8 Hz at 48 kHz
+    {    42275935,  1041052924,   262926444 },  //   1889.9 Hz at 48 kHz
+    {    44789793,  1037072708,   278211617 },  //   2002.3 Hz at 48 kHz
+    {    47453133,  1032611012,   294339944 },  //   2121.3 Hz at 48 kHz
+    {    50274843,  1027610412,   311349234 },  //   2247.5 Hz at 48 kHz
+    {    53264341,  1022006850,   329277243 },  //   2381.1 Hz at 48 kHz
+    {    56431603,  1015728922,   348161259 },  //   2522.7 Hz at 48 kHz
+    {    59787201,  1008697106,   368037569 },  //   2672.7 Hz at 48 kHz
+    {    63342333,  1000822935,   388940816 },  //   2831.6 Hz at 48 kHz
+    {    67108864,   992008094,   410903207 },  //   3000.0 Hz at 48 kHz
+    {    71099365,   982143478,   433953562 },  //   3178.4 Hz at 48 kHz
+    {    75327153,   971108177,   458116157 },  //   3367.4 Hz at 48 kHz
+    {    79806339,   958768437,   483409339 },  //   3567.6 Hz at 48 kHz
+    {    84551870,   944976579,   509843869 },  //   3779.8 Hz at 48 kHz
+    {    89579586,   929569916,   537420948 },  //   4004.5 Hz at 48 kHz
+    {    94906266,   912369694,   566129885 },  //   4242.6 Hz at 48 kHz
+    {   100549686,   893180085,   595945333 },  //   4494.9 Hz at 48 kHz
+    {   106528681,   871787312,   626824048 },  //   4762.2 Hz at 48 kHz
+    {   112863206,   847958941,   658701100 },  //   5045.4 Hz at 48 kHz
+    {   119574402,   821443460,   691485463 },  //   5345.4 Hz at 48 kHz
+    {   126684666,   791970257,   725054906 },  //   5663.2 Hz at 48 kHz
+    {   134217728,   759250125,   759250125 },  //   6000.0 Hz at 48 kHz
+    {   142198729,   722976510,   793868043 },  //   6356.8 Hz at 48 kHz
+    {   150654306,   682827716,   828654219 },  //   6734.8 Hz at 48 kHz
+    {   159612677,   638470357,   863294334 },  //   7135.2 Hz at 48 kHz
+    {   169103741,   589564409,   897404765 },  //   7559.5 Hz at 48 kHz
+    {   179159172,   535770276,   930522281 },  //   8009.0 Hz at 48 kHz
+    {   189812531,   476758378,   962093007 },  //   8485.3 Hz at 48 kHz
+    {   201099372,   412221836,   991460873 },  //   8989.8 Hz at 48 kHz
+    {   213057363,   341892924,  1017855949 },  //   9524.4 Hz at 48 kHz
+    {   225726413,   265564048,  1040383218 },  //  10090.8 Hz at 48 kHz
+    {   239148804,   183114049,  1058012642 },  //  10690.8 Hz at 48 kHz
+    {   253369332,    94540671,  1069571674 },  //  11326.5 Hz at 48 kHz
+    {   268435456,           0,  1073741824 },  //  12000.0 Hz at 48 kHz
+    {   284397459,  -100146454,  1069061360 },  //  12713.6 Hz at 48 kHz
+    {   301308612,  -205276650,  1053936906 },  //  13469.5 Hz at 48 kHz
+    {   319225354,  -314444965,  1026667360 },  //  14270.5 Hz at 48 kHz
+    {   338207482,  -426312089,   985484402 },  //  15119.1 Hz at 48 kHz
+    {   358318345,  -539069928,   928614623 },  //  16018.1 Hz at 48 kHz
+    {   379625062,  -650365280,   854369070 },  //  16970.6 Hz at 48 kHz
+    {   402198743,  -757228416,   761266464 },  //  17979.7 Hz at 48 kHz
+    {   426114725,  -856015796,   648196314 },  //  19048.8 Hz at 48 kHz
+    {   451452825,  -942380147,   514627209 },  //  20181.5 Hz at 48 kHz
+    {   478297607, -1011285926,   360863243 },  //  21381.6 Hz at 48 kHz
+    {   506738663, -1057093616,   188346996 },  //  22653.0 Hz at 48 kHz
+    {   536870912, -1073741824,           0 }   //  24000.0 Hz at 48 kHz
+};
+
+const int32_t eq32GainTable[EQ32_GAIN_STEPS][EQ32_GAIN_COLS] = {
+    {    67427938,   134536424 },  // -24.0 dB
+    {    69396869,   136486557 },  // -23.5 dB
+    {    71423294,   138464958 },  // -23.0 dB
+    {    73508892,   140472036 },  // -22.5 dB
+    {    75655391,   142508208 },  // -22.0 dB
+    {    77864568,   144573894 },  // -21.5 dB
+    {    80138254,   146669523 },  // -21.0 dB
+    {    82478334,   148795528 },  // -20.5 dB
+    {    84886745,   150952350 },  // -20.0 dB
+    {    87365482,   153140436 },  // -19.5 dB
+    {    89916600,   155360238 },  // -19.0 dB
+    {    92542213,   157612217 },  // -18.5 dB
+    {    95244494,   159896839 },  // -18.0 dB
+    {    98025683,   162214577 },  // -17.5 dB
+    {   100888085,   164565911 },  // -17.0 dB
+    {   103834070,   166951328 },  // -16.5 dB
+    {   106866080,   169371322 },  // -16.0 dB
+    {   109986626,   171826395 },  // -15.5 dB
+    {   113198293,   174317054 },  // -15.0 dB
+    {   116503743,   176843816 },  // -14.5 dB
+    {   119905714,   179407204 },  // -14.0 dB
+    {   123407024,   182007749 },  // -13.5 dB
+    {   127010574,   184645989 },  // -13.0 dB
+    {   130719350,   187322471 },  // -12.5 dB
+    {   134536424,   190037749 },  // -12.0 dB
+    {   138464958,   192792386 },  // -11.5 dB
+    {   142508208,   195586952 },  // -11.0 dB
+    {   146669523,   198422025 },  // -10.5 dB
+    {   150952350,   201298194 },  // -10.0 dB
+    {   155360238,   204216053 },  //  -9.5 dB
+    {   159896839,   207176207 },  //  -9.0 dB
+    {   164565911,   210179270 },  //  -8.5 dB
+    {   169371322,   213225862 },  //  -8.0 dB
+    {   174317054,   216316615 },  //  -7.5 dB
+    {   179407204,   219452169 },  //  -7.0 dB
+    {   184645989,   222633174 },  //  -6.5 dB
+    {   190037749,   225860289 },  //  -6.0 dB
+    {   195586952,   229134180 },  //  -5.5 dB
+    {   201298194,   232455528 },  //  -5.0 dB
+    {   207176207,   235825019 },  //  -4.5 dB
+    {   213225862,   239243352 },  //  -4.0 dB
+    {   219452169,   242711234 },  //  -3.5 dB
+    {   225860289,   246229384 },  //  -3.0 dB
+    {   232455528,   249798530 },  //  -2.5 dB
+    {   239243352,   253419412 },  //  -2.0 dB
+    {   246229384,   257092779 },  //  -1.5 dB
+    {   253419412,   260819392 },  //  -1.0 dB
+    {   260819392,   264600024 },  //  -0.5 dB
+    {   268435456,   268435456 },  //  +0.0 dB
+    {   276273913,   272326484 },  //  +0.5 dB
+    {   284341257,   276273913 },  //  +1.0 dB
+    {   292644171,   280278561 },  //  +1.5 dB
+    {   301189535,   284341257 },  //  +2.0 dB
+    {   309984429,   288462842 },  //  +2.5 dB
+    {   319036137,   292644171 },  //  +3.0 dB
+    {   328352161,   296886109 },  //  +3.5 dB
+    {   337940217,   301189535 },  //  +4.0 dB
+    {   347808249,   305555340 },  //  +4.5 dB
+    {   357964434,   309984429 },  //  +5.0 dB
+    {   368417184,   314477717 },  //  +5.5 dB
+    {   379175160,   319036137 },  //  +6.0 dB
+    {   390247274,   323660633 },  //  +6.5 dB
+    {   401642701,   328352161 },  //  +7.0 dB
+    {   413370879,   333111694 },  //  +7.5 dB
+    {   425441527,   337940217 },  //  +8.0 dB
+    {   437864644,   342838731 },  //  +8.5 dB
+    {   450650522,   347808249 },  //  +9.0 dB
+    {   463809755,   352849802 },  //  +9.5 dB
+    {   477353244,   357964434 },  // +10.0 dB
+    {   491292211,   363153203 },  // +10.5 dB
+    {   505638202,   368417184 },  // +11.0 dB
+    {   520403104,   373757468 },  // +11.5 dB
+    {   535599149,   379175160 },  // +12.0 dB
+    {   551238927,   384671383 },  // +12.5 dB
+    {   567335394,   390247274 },  // +13.0 dB
+    {   583901887,   395903990 },  // +13.5 dB
+    {   600952130,   401642701 },  // +14.0 dB
+    {   618500249,   407464595 },  // +14.5 dB
+    {   636560782,   413370879 },  // +15.0 dB
+    {   655148692,   419362776 },  // +15.5 dB
+    {   674279380,   425441527 },  // +16.0 dB
+    {   693968693,   431608390 },  // +16.5 dB
+    {   714232945,   437864644 },  // +17.0 dB
+    {   735088923,   444211583 },  // +17.5 dB
+    {   756553907,   450650522 },  // +18.0 dB
+    {   778645680,   457182795 },  // +18.5 dB
+    {   801382545,   463809755 },  // +19.0 dB
+    {   824783337,   470532774 },  // +19.5 dB
+    {   848867446,   477353244 },  // +20.0 dB
+    {   873654823,   484272579 },  // +20.5 dB
+    {   899166004,   491292211 },  // +21.0 dB
+    {   925422125,   498413594 },  // +21.5 dB
+    {   952444939,   505638202 },  // +22.0 dB
+    {   980256834,   512967533 },  // +22.5 dB
+    {  1008880850,   520403104 },  // +23.0 dB
+    {  1038340703,   527946456 },  // +23.5 dB
+    {  1068660799,   535599149 }   // +24.0 dB
+};
+
+const int32_t eq32QTable[EQ32_Q_STEPS][EQ32_Q_COLS] = {
+    {     1677722,  1244923292,   167772160 },  // Q  0.100
+    {     1883179,   721428308,   149468002 },  // Q  0.112
+    {     2113797,   443642867,   133160852 },  // Q  0.126
+    {     2372657,   287596603,   118632832 },  // Q  0.141
+    {     2663217,   195358924,   105689838 },  // Q  0.159
+    {     2989360,   138292417,    94158941 },  // Q  0.178
+    {     3355443,   101505587,    83886080 },  // Q  0.200
+    {     3766358,    76893940,    74734001 },  // Q  0.224
+    {     4227594,    59862081,    66580426 },  // Q  0.252
+    {     4745313,    47706385,    59316416 },  // Q  0.283
+    {     5326434,    38782522,    52844919 },  // Q  0.317
+    {     5978720,    32060086,    47079471 },  // Q  0.356
+    {     6710886,    26875742,    41943040 },  // Q  0.400
+    {     7532715,    22791898,    37367001 },  // Q  0.449
+    {     8455187,    19513358,    33290213 },  // Q  0.504
+    {     9490627,    16836820,    29658208 },  // Q  0.566
+    {    10652868,    14619524,    26422459 },  // Q  0.635
+    {    11957440,    12759342,    23539735 },  // Q  0.713
+    {    13421773,    11181885,    20971520 },  // Q  0.800
+    {    15065431,     9832007,    18683500 },  // Q  0.898
+    {    16910374,     8668111,    16777216 },  // Q  1.008
+    {    18981253,     7658279,    16777216 },  // Q  1.131
+    {    21305736,     6777609,    16777216 },  // Q  1.270
+    {    23914880,     6006358,    16777216 },  // Q  1.425
+    {    26843546,     5328631,    16777216 },  // Q  1.600
+    {    30130861,     4731449,    16777216 },  // Q  1.796
+    {    33820748,     4204075,    16777216 },  // Q  2.016
+    {    37962506,     3737520,    16777216 },  // Q  2.263
+    {    42611473,     3324182,    16777216 },  // Q  2.540
+    {    47829761,     2957575,    16777216 },  // Q  2.851
+    {    53687091,     2632120,    16777216 },  // Q  3.200
+    {    60261722,     2342987,    16777216 },  // Q  3.592
+    {    67641496,     2085976,    16777216 },  // Q  4.032
+    {    75925012,     1857412,    16777216 },  // Q  4.525
+    {    85222945,     1654072,    16777216 },  // Q  5.080
+    {    95659521,     1473120,    16777216 },  // Q  5.702
+    {   107374182,     1312054,    16777216 },  // Q  6.400
+    {   120523445,     1168662,    16777216 },  // Q  7.184
+    {   135282993,     1040986,    16777216 },  // Q  8.063
+    {   151850025,      927290,    16777216 },  // Q  9.051
+    {   170445890,      826035,    16777216 },  // Q 10.159
+    {   191319043,      735852,    16777216 },  // Q 11.404
+    {   214748365,      655527,    16777216 },  // Q 12.800
+    {   241046889,      583977,    16777216 },  // Q 14.368
+    {   270565985,      520243,    16777216 },  // Q 16.127
+    {   303700050,      463468,    16777216 },  // Q 18.102
+    {   340891780,      412893,    16777216 },  // Q 20.319
+    {   382638086,      367838,    16777216 },  // Q 22.807
+    {   429496730,      327701,    16777216 },  // Q 25.600
+    {   482093779,      291944,    16777216 }   // Q 28.735
+};
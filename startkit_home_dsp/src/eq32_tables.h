@@ -0,0 +1,56 @@
+/*---------------------------------------------------------------------------*\
+|   Design Tables for Fast EQ32 Coefficient Updates                           |
+|                                                                             |
+|   Trigonometric, gain and Q dependent factors of the cookbook formulae,     |
+|   sampled on fixed grids. With these a filter is redesigned with a few      |
+|   fixed-point multiplies instead of soft-float cos/sin/pow/sinh calls.      |
+|   Each table has its own fixed-point format, chosen so that the filter      |
+|   coefficients come out as exact as with the floating point designEQ().    |
+|                                                                             |
+|   The tables are generated by host/gen_eq32_tables.cpp; edit the grid      |
+|   here, then regenerate eq32_tables.cpp.                                    |
+\*---------------------------------------------------------------------------*/
+
+#ifndef EQ32_TABLES_H
+#define EQ32_TABLES_H
+
+#include <stdint.h>
+
+// frequency grid: 1/12 octave steps from fs/2 down by 11 octaves
+// (11.7 Hz .. 24 kHz at 48 kHz)
+#define EQ32_FREQ_STEPS_PER_OCTAVE  12
+#define EQ32_FREQ_OCTAVES           11
+#define EQ32_FREQ_STEPS             (EQ32_FREQ_STEPS_PER_OCTAVE * EQ32_FREQ_OCTAVES + 1)
+
+// gain grid: -24 dB .. +24 dB in 0.5 dB steps
+#define EQ32_GAIN_MIN_DB            (-24)
+#define EQ32_GAIN_STEPS_PER_DB      2
+#define EQ32_GAIN_STEPS             (48 * EQ32_GAIN_STEPS_PER_DB + 1)
+
+// Q grid: 1/6 octave steps from 0.1 (0.1 .. 28.5)
+#define EQ32_Q_MIN                  0.1
+#define EQ32_Q_STEPS_PER_OCTAVE     6
+#define EQ32_Q_STEPS                50
+
+// fractional bits of the table entries
+#define EQ32_FREQ_BITS              30
+#define EQ32_GAIN_BITS              28
+#define EQ32_Q_BITS                 24
+
+// table positions carry this many fractional bits for interpolation
+#define EQ32_TABLE_FRAC_BITS        8
+
+enum { EQ32_FREQ_NORM, EQ32_FREQ_COS, EQ32_FREQ_SIN, EQ32_FREQ_COLS };
+enum { EQ32_GAIN_A, EQ32_GAIN_SQRT_A, EQ32_GAIN_COLS };
+enum { EQ32_Q_VALUE, EQ32_Q_SINH, EQ32_Q_INV_S, EQ32_Q_COLS };
+
+// f0/fs, cos(2*pi*f0/fs), sin(2*pi*f0/fs)
+extern const int32_t eq32FreqTable[EQ32_FREQ_STEPS][EQ32_FREQ_COLS];
+
+// A = 10^(gain/40), sqrt(A)
+extern const int32_t eq32GainTable[EQ32_GAIN_STEPS][EQ32_GAIN_COLS];
+
+// Q, sinh(1/(2Q)), 1/min(Q,1)
+extern const int32_t eq32QTable[EQ32_Q_STEPS][EQ32_Q_COLS];
+
+#endif  // EQ32_TABLES_H
@@ -0,0 +1,153 @@
+/*---------------------------------------------------------------------------*\
+|   Fixed-Point FIR Filter                                                    |
+|                                                                             |
+|   Direct form FIR for short room-correction filters. Coefficients share     |
+|   the EQ32 format (integer_bits.fractional_bits, Q8.24), products are       |
+|   summed in 64 bits and the output is truncated like EQ32. The sum is       |
+|   exact, so the result does not depend on the order of the MACs.           |
+|                                                                             |
+|   Every channel has a delay line of twice the tap count: each sample is     |
+|   written at pos and pos + taps, so the last taps samples are always one    |
+|   contiguous window and the inner loop never wraps. Coefficients are        |
+|   stored time-reversed and padded to a multiple of 4 taps for the 4-way     |
+|   unrolled inner loop (four 64 bit accumulators).                           |
+\*---------------------------------------------------------------------------*/
+
+#ifndef FIR32_H
+#define FIR32_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "eq32.h"
+
+template <int MaxTaps, int NumChans>
+class FIR32
+{
+public:
+    enum { TapCapacity = (MaxTaps + 3) & ~3 };
+
+    // a single tap of 1.0 until coefficients are set
+    FIR32(void)
+    {
+        newCoefficients[0] = fixed_one;
+        newTaps = 1;
+        numTaps = 0;
+        paddedTaps = 0;
+        update_filter = true;
+        updateCoefficients();
+    }
+
+    // h[taps] in floating point, truncated to fixed point like
+    // EQ32Base::setCoefficients(); false if taps does not fit
+    bool setCoefficients(const double h[], int taps)
+    {
+        if (taps < 1 || taps > MaxTaps)
+            return false;
+
+        for (int k=0; k<taps; k++)
+            newCoefficients[k] = (int32_t)(h[k] * fixed_one);
+        newTaps = taps;
+        update_filter = true;
+        return true;
+    }
+
+    // h[taps] in integer_bits.fractional_bits
+    bool setCoefficients(const int32_t h[], int taps)
+    {
+        if (taps < 1 || taps > MaxTaps)
+            return false;
+
+        for (int k=0; k<taps; k++)
+            newCoefficients[k] = h[k];
+        newTaps = taps;
+        update_filter = true;
+        return true;
+    }
+
+    int getTaps(void) const
+    {
+        return numTaps;
+    }
+
+    void resetStates(void)
+    {
+        for (int c=0; c<NumChans; c++)
+            for (int i=0; i<2*TapCapacity; i++)
+                delayLine[c][i] = 0;
+        pos = 0;
+    }
+
+    // interleaved block: samples[frame * NumChans + channel]
+    inline void processBlock(int32_t *interleaved, size_t frames)
+    {
+        // pending coefficients are only taken at the block boundary
+        if (expected_false(update_filter))
+            updateCoefficients();
+
+        const int n4 = paddedTaps;
+        int w = pos;
+
+        for (int c=0; c<NumChans; c++)
+        {
+            int32_t *line = delayLine[c];
+            int32_t *p = interleaved + c;
+
+            w = pos;
+            for (size_t n=0; n<frames; n++, p+=NumChans)
+            {
+                line[w] = *p;
+                line[w + n4] = *p;
+                if (++w == n4)
+                    w = 0;
+
+                // window: line[w .. w + n4 - 1], oldest sample first
+                const int32_t *x = line + w;
+                const int32_t *h = coefficients;
+                int64_t acc0 = 0, acc1 = 0, acc2 = 0, acc3 = 0;
+
+                for (int k=0; k<n4; k+=4)
+                {
+                    acc0 += (int64_t) h[k]     * x[k];
+                    acc1 += (int64_t) h[k + 1] * x[k + 1];
+                    acc2 += (int64_t) h[k + 2] * x[k + 2];
+                    acc3 += (int64_t) h[k + 3] * x[k + 3];
+                }
+
+                *p = (int32_t) ((acc0 + acc1 + acc2 + acc3) >> fractional_bits);
+            }
+        }
+        pos = w;
+    }
+
+private:
+    bool    update_filter;                      // flag for coefficient update
+    int     numTaps;
+    int     newTaps;
+    int     paddedTaps;                         // numTaps rounded up to 4
+    int     pos;                                // next write position
+    int32_t newCoefficients[MaxTaps];
+    int32_t coefficients[TapCapacity];          // h[paddedTaps - 1 - k]
+    int32_t delayLine[NumChans][2 * TapCapacity];
+
+    // a new tap count restarts the delay line
+    void updateCoefficients(void)
+    {
+        int padded = (newTaps + 3) & ~3;
+
+        for (int k=0; k<padded; k++)
+        {
+            int src = padded - 1 - k;
+            coefficients[k] = src < newTaps ? newCoefficients[src] : 0;
+        }
+
+        if (padded != paddedTaps || numTaps == 0)
+        {
+            paddedTaps = padded;
+            resetStates();
+        }
+        numTaps = newTaps;
+        update_filter = false;
+    }
+};
+
+#endif  // FIR32_H
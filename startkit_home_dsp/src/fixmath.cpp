@@ -0,0 +1,173 @@
+/*---------------------------------------------------------------------------*\
+|   Fixed-Point Math Functions                                                |
+\*---------------------------------------------------------------------------*/
+
+#include "fixmath.h"
+
+// pi/2 in Q2.30
+#define PI_2_Q30        1686629713
+
+// Taylor coefficients in Q2.30, (-1)^k / (2k+1)! and (-1)^k / (2k)!
+static const int32_t sinCoeffs[] = {
+    1073741824, -178956971, 8947849, -213044, 2959, -27
+};
+static const int32_t cosCoeffs[] = {
+    1073741824, -536870912, 44739243, -1491308, 26631, -296, 2
+};
+
+// (ln 2)^k / k! in Q2.30, coefficients of 2^f
+static const int32_t exp2Coeffs[] = {
+    1073741824, 744261118, 257941248, 59597083, 10327387,
+    1431680, 165394, 16377, 1419, 109, 8
+};
+
+#define NUM_SIN_COEFFS  (sizeof(sinCoeffs) / sizeof(sinCoeffs[0]))
+#define NUM_COS_COEFFS  (sizeof(cosCoeffs) / sizeof(cosCoeffs[0]))
+#define NUM_EXP2_COEFFS (sizeof(exp2Coeffs) / sizeof(exp2Coeffs[0]))
+
+int64_t fix_mul_shift(int64_t a, int64_t b, int shift)
+{
+    int negative = (a < 0) != (b < 0);
+    uint64_t ua = a < 0 ? 0 - (uint64_t) a : (uint64_t) a;
+    uint64_t ub = b < 0 ? 0 - (uint64_t) b : (uint64_t) b;
+    uint64_t al = (uint32_t) ua, ah = ua >> 32;
+    uint64_t bl = (uint32_t) ub, bh = ub >> 32;
+    uint64_t ll = al*bl, lh = al*bh, hl = ah*bl, hh = ah*bh;
+    uint64_t mid = (ll >> 32) + (uint32_t) lh + (uint32_t) hl;
+    uint64_t lo = (mid << 32) | (uint32_t) ll;
+    uint64_t hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+    uint64_t r = (lo >> shift) | (hi << (64 - shift));
+
+    return negative ? -(int64_t) r : (int64_t) r;
+}
+
+// rounded Q2.30 product
+static inline int64_t mulQ30(int64_t a, int64_t b)
+{
+    return (a * b + (1 << 29)) >> 30;
+}
+
+// polynomial in x^2, x in Q2.30 with |x| <= 1
+static int64_t evenPoly(const int32_t *coeffs, int n, int64_t x2)
+{
+    int64_t acc = coeffs[n-1];
+
+    for (int k=n-2; k>=0; k--)
+        acc = coeffs[k] + mulQ30(acc, x2);
+    return acc;
+}
+
+int32_t fix_sincos(uint32_t phase, int32_t *cos_out)
+{
+    // reduce to the first octant, x in [0, pi/4]
+    uint32_t quadrant = phase >> 30;
+    uint32_t r = phase & 0x3FFFFFFF;
+    int mirrored = r > 0x20000000;
+    int64_t x, x2, s, c, t;
+
+    if (mirrored)
+        r = 0x40000000 - r;
+
+    x = ((int64_t) r * PI_2_Q30) >> 30;
+    x2 = mulQ30(x, x);
+    s = mulQ30(x, evenPoly(sinCoeffs, NUM_SIN_COEFFS, x2));
+    c = evenPoly(cosCoeffs, NUM_COS_COEFFS, x2);
+
+    if (mirrored)
+    {
+        t = s; s = c; c = t;
+    }
+
+    switch (quadrant)
+    {
+    case 1:  t = s; s = c;  c = -t; break;
+    case 2:  s = -s; c = -c;        break;
+    case 3:  t = s; s = -c; c = t;  break;
+    default:                        break;
+    }
+
+    if (cos_out)
+        *cos_out = (int32_t) c;
+    return (int32_t) s;
+}
+
+int64_t fix_exp2(int64_t x, int frac_bits)
+{
+    int64_t i, f, acc;
+
+    if (x < -((int64_t) 30 << frac_bits))
+        x = -((int64_t) 30 << frac_bits);
+    if (x >= (int64_t) 32 << frac_bits)
+        x = ((int64_t) 32 << frac_bits) - 1;
+
+    // x = i + f, 0 <= f < 1 in Q2.30
+    i = x >> frac_bits;
+    f = (x - (i << frac_bits)) << (30 - frac_bits);
+
+    acc = exp2Coeffs[NUM_EXP2_COEFFS-1];
+    for (int k=NUM_EXP2_COEFFS-2; k>=0; k--)
+        acc = exp2Coeffs[k] + mulQ30(acc, f);
+
+    return i >= 0 ? acc << i : acc >> -i;
+}
+
+int32_t fix_log2(uint32_t x, int frac_bits)
+{
+    int32_t result;
+    uint64_t m;
+
+    if (x == 0)
+        return INT32_MIN;
+
+    // x = 2^e * m, 1 <= m < 2 in Q2.30
+    int e = 31 - __builtin_clz(x);
+    result = (e - frac_bits) * (1 << 24);
+    m = e <= 30 ? (uint64_t) x << (30 - e) : (uint64_t) x >> (e - 30);
+
+    // one result bit per squaring of m
+    for (int32_t bit = 1 << 23; bit > 0; bit >>= 1)
+    {
+        m = (m * m) >> 30;
+        if (m >= (uint64_t) 2 << 30)
+        {
+            m >>= 1;
+            result += bit;
+        }
+    }
+    return result;
+}
+
+int64_t fix_sqrt(int64_t x, int frac_bits)
+{
+    uint64_t v, root = 0, bit = (uint64_t) 1 << 62;
+    int shift = frac_bits & 1;
+
+    if (x <= 0)
+        return 0;
+
+    // sqrt(x * 2^frac_bits), pre-shift as far as 64 bits allow
+    v = (uint64_t) x << shift;
+    while (shift + 2 <= frac_bits && v < ((uint64_t) 1 << 62))
+    {
+        v <<= 2;
+        shift += 2;
+    }
+
+    while (bit > v)
+        bit >>= 2;
+
+    while (bit)
+    {
+        if (v >= root + bit)
+        {
+            v -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+            root >>= 1;
+        bit >>= 2;
+    }
+
+    // root = sqrt(x * 2^shift), scale to frac_bits
+    return (int64_t) root << ((frac_bits - shift) / 2);
+}
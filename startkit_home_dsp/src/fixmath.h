@@ -0,0 +1,46 @@
+/*---------------------------------------------------------------------------*\
+|   Fixed-Point Math Functions                                                |
+|                                                                             |
+|   Integer replacements for the libm functions used in filter design, so    |
+|   that coefficients can be computed on a core without FPU and without      |
+|   linking software floating point. Qm.n denotes n fractional bits.         |
+\*---------------------------------------------------------------------------*/
+
+#ifndef FIXMATH_H
+#define FIXMATH_H
+
+#include <stdint.h>
+
+// 1.0 in Q2.30
+#define FIX_ONE_Q30 ((int64_t) 1 << 30)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// (a * b) >> shift, rounded towards zero, without overflow of the 128 bit
+// product, 0 < shift < 64
+int64_t fix_mul_shift(int64_t a, int64_t b, int shift);
+
+// sin and cos in Q2.30 of a phase given as fraction of a full turn,
+// 2^32 = 2*pi. Error below 2e-9.
+int32_t fix_sincos(uint32_t phase, int32_t *cos_out);
+
+// 2^x for x with frac_bits fractional bits (at most 30), -30 <= x < 32,
+// result in Q2.30 (64 bit). Error below 2e-9, relative for x >= 0,
+// absolute for x < 0.
+int64_t fix_exp2(int64_t x, int frac_bits);
+
+// log2 of x / 2^frac_bits for x > 0, result in Q8.24 (error about 1 LSB).
+// Returns INT32_MIN for x = 0.
+int32_t fix_log2(uint32_t x, int frac_bits);
+
+// square root of x / 2^frac_bits, result in the same format,
+// 0 <= x < 2^(64 - frac_bits)
+int64_t fix_sqrt(int64_t x, int frac_bits);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // FIXMATH_H
@@ -12,6 +12,30 @@
 #define SAMPLE_FREQUENCY 48000
 #define MASTER_CLOCK_FREQUENCY 24576000
 #define CODEC_I2C_DEVICE_ADDR 0x48
-#define NUM_CHANS 2
+
+// 1: the processed channels go to a TDM DAC (tdm_slot_map.h), the codec
+//    delivers the stereo input and plays channels 0 and 1.
+// 0: stereo in and out on the codec
+#ifndef TDM_OUTPUT
+#define TDM_OUTPUT 0
+#endif
+
+// channels of the CS4270 in each direction
+#define CODEC_CHANS 2
+
+#if TDM_OUTPUT
+// stereo x 4 bands for a multi-way active speaker
+#define NUM_CHANS 8
+// the TDM bit clock is MCLK, 32 bit slots: 512 fs = 16 slots per frame
+#define TDM_CHANS_PER_FRAME (MASTER_CLOCK_FREQUENCY / (32 * SAMPLE_FREQUENCY))
+#else
+#define NUM_CHANS CODEC_CHANS
+#endif
+
+// frames per block exchanged between i2s_handler and audio_effects,
+// the I2S to I2S latency is 2 blocks (host/blocksim models the handoff)
+#ifndef DSP_BLOCK_FRAMES
+#define DSP_BLOCK_FRAMES 16
+#endif
 
 #endif /* GLOBAL_DEFINES_H_ */
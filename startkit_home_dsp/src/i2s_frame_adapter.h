@@ -0,0 +1,62 @@
+/*
+ * i2s_frame_adapter.h
+ *
+ *  Frame based I2S callbacks for all xCORE parts. lib_i2s only provides
+ *  i2s_frame_callback_if and i2s_frame_master on xCORE-200 (__XS2A__).
+ *  On XS1 the same interface is declared here and i2s_frame_adapter
+ *  emulates it on top of the per-sample i2s_master. i2s_tdm_master has
+ *  no frame variant, the TDM output mode uses the adapter on all parts.
+ */
+
+#ifndef I2S_FRAME_ADAPTER_H_
+#define I2S_FRAME_ADAPTER_H_
+
+#include <i2s.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "global_defines.h"
+
+// channels per frame callback, i2s_tdm_master numbers the codec
+// channels first and the TDM slots after them
+#if TDM_OUTPUT
+#define I2S_FRAME_IN_CHANS  (CODEC_CHANS + TDM_CHANS_PER_FRAME)
+#define I2S_FRAME_OUT_CHANS (CODEC_CHANS + TDM_CHANS_PER_FRAME)
+#else
+#define I2S_FRAME_IN_CHANS  CODEC_CHANS
+#define I2S_FRAME_OUT_CHANS CODEC_CHANS
+#endif
+
+#if !defined(__XS2A__)
+
+/** Same as the xCORE-200 interface of lib_i2s: one call per frame with
+ *  all channels as an array.
+ */
+typedef interface i2s_frame_callback_if {
+  void init(i2s_config_t &?i2s_config, tdm_config_t &?tdm_config);
+  i2s_restart_t restart_check();
+  void receive(size_t num_in, int32_t samples[num_in]);
+  void send(size_t num_out, int32_t samples[num_out]);
+} i2s_frame_callback_if;
+
+#endif // !__XS2A__
+
+/** Turns the per-sample callbacks of i2s_master or i2s_tdm_master into
+ *  frame callbacks.
+ *
+ *  Frames are aligned on the restart check that starts each one: it
+ *  passes on the samples received since the previous check as the input
+ *  frame and then requests the output frame. Samples are stored by
+ *  channel index, so extra or missing per-sample calls (e.g. data lines
+ *  beyond I2S_FRAME_IN_CHANS) cannot shift later frames. Being
+ *  distributable, the task runs inside the master's logical core and
+ *  only the frame calls cross to the application, which must not be
+ *  distributable itself (it would be distributed into the adapter).
+ *
+ *  \param i2s      per-sample callbacks from the I2S/TDM master
+ *  \param i_frame  frame callbacks to the application
+ */
+[[distributable]]
+void i2s_frame_adapter(server i2s_callback_if i2s,
+                       client i2s_frame_callback_if i_frame);
+
+#endif /* I2S_FRAME_ADAPTER_H_ */
@@ -14,31 +14,31 @@ FixedPoint Adaption, Hagen Jaeger, 02.05.2020
 #include <math.h>
 #include <stdint.h>
 #include "limiter32.h"
-
-#define abs(x) ((x)<0 ? -(x) : (x))
-#define max(x,y) ((x)>(y) ? (x) : (y))
-#define min(x,y) ((x)<(y) ? (x) : (y))
-
-Limiter32::Limiter32(int32_t channnels)
+#include "fixmath.h"
+
+const uint32_t Limiter32Base::recipTable[32] = {
+    0x7E07E07E, 0x7A44C6B0, 0x76B981DB, 0x73615A24,
+    0x70381C0E, 0x6D3A06D4, 0x6A63BD82, 0x67B23A54,
+    0x6522C3F3, 0x62B2E43E, 0x60606060, 0x5E293206,
+    0x5C0B8170, 0x5A05A05A, 0x58160581, 0x563B48C2,
+    0x54741FAC, 0x52BF5A81, 0x511BE196, 0x4F88B2F4,
+    0x4E04E04E, 0x4C8F8D29, 0x4B27ED36, 0x49CD42E2,
+    0x487EDE05, 0x473C1AB7, 0x46046046, 0x44D72045,
+    0x43B3D5B0, 0x429A042A, 0x4189374C, 0x40810204
+};
+
+Limiter32Base::Limiter32Base(void)
 {
     double tAtt = 0.002, tHold = 0.01, tRel = 1.0;
     int32_t fs = 48000;
-    bAtt = (int32_t)(1. / (tAtt * fs) * 0x7FFFFFFF);
+#if (!LIMITER_ATTACK_AVERAGE)
+    bAtt = onePoleCoeff(tAtt, fs);
     aAtt = 0x7FFFFFFF - bAtt;
-    bRel = (int32_t)(1. / (tRel * fs) * 0x7FFFFFFF);
+#endif
+    bRel = onePoleCoeff(tRel, fs);
     aRel = 0x7FFFFFFF - bRel;
     nHoldSamps = (int32_t)(tHold * fs);
     nLookaheadSamps = (int32_t)(tAtt * fs);
-    if (channnels > MAX_LIMITER_CHANS)
-        channnels = MAX_LIMITER_CHANS;
-    nChans = channnels;
-
-    for (int i = 0; i < nChans; i++)
-    {
-        lookaheadMem[i] = new int32_t[nLookaheadSamps];
-        for (int j = 0; j < nLookaheadSamps; j++)
-            lookaheadMem[i][j] = 0;
-    }
 
     thresholdLin = 0x40000000; // threshold -6 dBFS
 
@@ -48,30 +48,19 @@ Limiter32::Limiter32(int32_t channnels)
     relState = 0x7FFFFFFF;
 }
 
-Limiter32::Limiter32(double threshold, double tAtt, double tHold, double tRel,
-                     int32_t channnels, int32_t fs)
+Limiter32Base::Limiter32Base(double threshold, double tAtt, double tHold, double tRel,
+                             int32_t fs)
 {
-    if (channnels > MAX_LIMITER_CHANS)
-        channnels = MAX_LIMITER_CHANS;
-    nChans = channnels;
-    bAtt = (int32_t)(1. / (tAtt * fs) * 0x7FFFFFFF);
+#if (!LIMITER_ATTACK_AVERAGE)
+    bAtt = onePoleCoeff(tAtt, fs);
     aAtt = 0x7FFFFFFF - bAtt;
-    bRel = (int32_t)(1. / (tRel * fs) * 0x7FFFFFFF);
+#endif
+    bRel = onePoleCoeff(tRel, fs);
     aRel = 0x7FFFFFFF - bRel;
     nHoldSamps = (int32_t)(tHold * fs);
     nLookaheadSamps = (int32_t)(tAtt * fs);
 
-    for (int i = 0; i < nChans; i++)
-    {
-        lookaheadMem[i] = new int32_t[nLookaheadSamps];
-        for (int j = 0; j < nLookaheadSamps; j++)
-            lookaheadMem[i][j] = 0;
-    }
-
-    if (threshold >= 0)
-        thresholdLin = 0x7FFFFFFF; // threshold 0 dBFS
-    else
-        thresholdLin = (int32_t)(pow(10., threshold / 20.) * 0x7FFFFFFF);
+    setThreshold(threshold);
 
     lookaheadCnt = 0;
     holdCnt = nHoldSamps;
@@ -79,66 +68,33 @@ Limiter32::Limiter32(double threshold, double tAtt, double tHold, double tRel,
     relState = 0x7FFFFFFF;
 }
 
-Limiter32::~Limiter32(void)
-{
-    for (int i = 0; i < nChans; i++)
-    {
-        delete[] lookaheadMem[i];
-    }
-}
-
-void Limiter32::setThreshold(double threshold)
+void Limiter32Base::setThreshold(double threshold)
 {
     if (threshold >= 0)
         thresholdLin = 0x7FFFFFFF;  // threshold 0 dBFS
     else
+    {
+#if (LIMITER_FIXED_DESIGN)
+        // 10^(threshold/20) = 2^(threshold * log2(10)/20), Q2.30 -> Q1.31
+        const int64_t log2_10_div_20 = 178344657;   // log2(10)/20 in Q2.30
+        if (threshold < -120)
+            threshold = -120;
+        int64_t exponent = ((int64_t)(threshold * (1 << 24)) * log2_10_div_20) >> 24;
+        int64_t lin = fix_exp2(exponent, 30) << 1;
+        thresholdLin = lin > 0x7FFFFFFF ? 0x7FFFFFFF : (int32_t)lin;
+#else
         thresholdLin = (int32_t)(pow(10., threshold / 20.) * 0x7FFFFFFF);
+#endif
+    }
 }
 
-int32_t Limiter32::process(int32_t inSamps[])
+void Limiter32Base::getFixedParams(int32_t &threshold, int32_t &lookahead, int32_t &hold,
+                                   int32_t &release) const
 {
-    int32_t gainTmp, tmp32, maxVal;
-
-    maxVal = 0;
-    for (int i = 0; i < nChans; i++)
-        maxVal = max(abs(inSamps[i]), maxVal);
-
-    // gain = thresholdLin / maxVal
-    maxVal = maxVal & 0xFFFF0000;
-    if (maxVal > thresholdLin)
-        gainTmp = (thresholdLin / (maxVal >> 16)) << 15;
-    else
-        gainTmp = 0x7FFFFFFF;
-
-    tmp32 = (((int64_t)gainTmp * bRel) >> 31) + (((int64_t)relState * aRel) >> 31);
-
-    if (gainTmp < tmp32)
-    {
-        relState = gainTmp;
-        holdCnt = nHoldSamps;
-    }
-    else
-    {
-        if (holdCnt > 0)
-            holdCnt--;
-        else
-            relState = tmp32;
-    }
-
-    gain = (((int64_t)relState * bAtt) >> 31) + (((int64_t)gain * aAtt) >> 31);
-
-    for (int i = 0; i < nChans; i++)
-    {
-        tmp32 = ((int64_t)gain * lookaheadMem[i][lookaheadCnt]) >> 31;
-        lookaheadMem[i][lookaheadCnt] = inSamps[i];
-        inSamps[i] = max(min(tmp32, thresholdLin), -thresholdLin);
-    }
-
-    lookaheadCnt++;
-    if (lookaheadCnt >= nLookaheadSamps)
-        lookaheadCnt = 0;
-
-    return gain;
+    threshold = thresholdLin;
+    lookahead = nLookaheadSamps;
+    hold = nHoldSamps;
+    release = bRel;
 }
 
 //--------------------- License ------------------------------------------------
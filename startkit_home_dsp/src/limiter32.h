@@ -21,33 +21,318 @@ extern "C" {
 #define MAX_LIMITER_CHANS 2
 #endif
 
+// 1: gain computer uses a reciprocal table and Newton-Raphson instead
+//    of an integer division (differs by less than one quotient LSB)
+#ifndef LIMITER_DIVISION_FREE
+#define LIMITER_DIVISION_FREE 0
+#endif
+
+// 1: setThreshold() uses fixed-point exp2 (fixmath.h) instead of pow()
+#ifndef LIMITER_FIXED_DESIGN
+#define LIMITER_FIXED_DESIGN 0
+#endif
+
+// 1: the attack is a moving average of the release gain over the
+//    lookahead window, the gain is down when a peak leaves the delay line
+// 0: one-pole attack with the lookahead as time constant, as before the
+//    window peak; cheaper, but lets part of sudden peaks into the hard clip
+#ifndef LIMITER_ATTACK_AVERAGE
+#define LIMITER_ATTACK_AVERAGE 1
+#endif
+
+// default lookahead capacity in frames (2 ms at 48 kHz)
+#ifndef MAX_LIMITER_LOOKAHEAD
+#define MAX_LIMITER_LOOKAHEAD 96
+#endif
+
 #include <stdint.h>
 
-class Limiter32
+}
+
+// one-pole smoothing y = b * x + a * y with a = 1 - b, all Q31; the
+// release (and one-pole attack) of Limiter32 and the envelope of Dynamics32
+inline int32_t onePoleSmooth(int32_t x, int32_t y, int32_t a, int32_t b)
+{
+    return (((int64_t)x * b) >> 31) + (((int64_t)y * a) >> 31);
+}
+
+// b of onePoleSmooth() for time constant t (s) at rate fs, 0 < b <= 1
+inline int32_t onePoleCoeff(double t, int32_t fs)
+{
+    double b = t * fs > 1. ? 1. / (t * fs) : 1.;
+
+    return (int32_t)(b * 0x7FFFFFFF);
+}
+
+// channel independent part: time constants and the gain computer
+class Limiter32Base
 {
 public:
-    Limiter32(int32_t nChans);
-    Limiter32(double threshold, double tAtt, double tHold, double tRel, int32_t nChans, int32_t fs);
-    ~Limiter32(void);
+    Limiter32Base(void);
+    Limiter32Base(double threshold, double tAtt, double tHold, double tRel, int32_t fs);
     void setThreshold(double threshold);
-    int32_t process(int32_t inSamps[]);
 
-private:
-    int32_t nChans;
+    // settings in the internal fixed-point form: threshold Q1.31, lookahead
+    // and hold in samples, release coefficient Q31
+    void getFixedParams(int32_t &threshold, int32_t &lookahead, int32_t &hold,
+                        int32_t &release) const;
+
+protected:
+#if (!LIMITER_ATTACK_AVERAGE)
     int32_t aAtt;
     int32_t bAtt;
+#endif
     int32_t aRel;
     int32_t bRel;
     int32_t nHoldSamps;
     int32_t nLookaheadSamps;
     int32_t thresholdLin;
-    int32_t *lookaheadMem[MAX_LIMITER_CHANS];
     int32_t lookaheadCnt;
     int32_t holdCnt;
     int32_t gain;
     int32_t relState;
+
+    // 1/x for x in [0.5, 1), 32 segments, Q30
+    static const uint32_t recipTable[32];
+
+    // (thresholdLin / d) << 15 without a division, d in [1, 0x7FFF]
+    inline int32_t divideThreshold(int32_t d)
+    {
+        int shift = __builtin_clz((uint32_t)d);
+        uint32_t x = (uint32_t)d << shift;      // [0.5, 1), Q32
+        uint32_t r = recipTable[(x >> 26) & 31];// 1/x, Q30, ~6 bits
+        uint32_t e;
+
+        // two Newton-Raphson steps r = r * (2 - x * r), ~24 bits
+        e = (uint32_t)(((uint64_t)x * r) >> 32);
+        r = (uint32_t)(((uint64_t)r * ((2u << 30) - e)) >> 30);
+        e = (uint32_t)(((uint64_t)x * r) >> 32);
+        r = (uint32_t)(((uint64_t)r * ((2u << 30) - e)) >> 30);
+
+        // 1/d = r * 2^(shift - 62)
+        return (int32_t)(((uint64_t)thresholdLin * r) >> (47 - shift));
+    }
+
+    // maxVal: absolute peak, returns the gain after hold and release
+    inline int32_t computeReleaseGain(int32_t maxVal)
+    {
+        int32_t gainTmp, tmp32;
+
+        // gain = thresholdLin / maxVal
+        maxVal = maxVal & 0xFFFF0000;
+        if (maxVal > thresholdLin)
+#if (LIMITER_DIVISION_FREE)
+            gainTmp = divideThreshold(maxVal >> 16);
+#else
+            gainTmp = (thresholdLin / (maxVal >> 16)) << 15;
+#endif
+        else
+            gainTmp = 0x7FFFFFFF;
+
+        tmp32 = onePoleSmooth(gainTmp, relState, aRel, bRel);
+
+        if (gainTmp < tmp32)
+        {
+            relState = gainTmp;
+            holdCnt = nHoldSamps;
+        }
+        else
+        {
+            if (holdCnt > 0)
+                holdCnt--;
+            else
+                relState = tmp32;
+        }
+
+        return relState;
+    }
 };
 
-}
+// NumChans is a compile-time constant, so both channel loops unroll.
+// The lookahead delay line is a static, channel-interleaved array of
+// MaxLookahead frames, longer attack times are clamped to it.
+// The gain is computed from the peak of the whole lookahead window,
+// tracked by a monotonic deque (amortised O(1) per frame). The attack is
+// a moving average over the same window, so the gain has reached its
+// target when the peak leaves the delay line and nothing is hard clipped
+// (one-pole attack with LIMITER_ATTACK_AVERAGE 0).
+template <int NumChans, int MaxLookahead = MAX_LIMITER_LOOKAHEAD>
+class Limiter32N : public Limiter32Base
+{
+public:
+    Limiter32N(void) : Limiter32Base()
+    {
+        initLookahead();
+    }
+
+    Limiter32N(double threshold, double tAtt, double tHold, double tRel, int32_t fs)
+        : Limiter32Base(threshold, tAtt, tHold, tRel, fs)
+    {
+        initLookahead();
+    }
+
+    // see getFixedParams(), a new lookahead restarts the delay line
+    void setFixedParams(int32_t threshold, int32_t lookahead, int32_t hold,
+                        int32_t release)
+    {
+        thresholdLin = threshold;
+        nHoldSamps = hold;
+        bRel = release;
+        aRel = 0x7FFFFFFF - bRel;
+#if (!LIMITER_ATTACK_AVERAGE)
+        bAtt = 0x7FFFFFFF / (lookahead > 1 ? lookahead : 1);
+        aAtt = 0x7FFFFFFF - bAtt;
+#endif
+
+        if (lookahead > MaxLookahead)
+            lookahead = MaxLookahead;
+        if (lookahead < 1)
+            lookahead = 1;
+
+        if (lookahead != nLookaheadSamps)
+        {
+            nLookaheadSamps = lookahead;
+            initLookahead();
+        }
+    }
+
+    // clears the delay line and restarts the gain at 0 dB
+    void resetStates(void)
+    {
+        holdCnt = nHoldSamps;
+        gain = 0x7FFFFFFF;
+        relState = 0x7FFFFFFF;
+        initLookahead();
+    }
+
+    inline int32_t process(int32_t inSamps[])
+    {
+        int32_t tmp32, maxVal;
+        int32_t *frame = &lookaheadMem[lookaheadCnt * NumChans];
+
+        maxVal = 0;
+        for (int i = 0; i < NumChans; i++)
+        {
+            tmp32 = inSamps[i] < 0 ? -inSamps[i] : inSamps[i];
+            if (tmp32 > maxVal)
+                maxVal = tmp32;
+        }
+
+#if (LIMITER_ATTACK_AVERAGE)
+        gain = attackAverage(computeReleaseGain(windowPeak(maxVal)));
+#else
+        gain = onePoleSmooth(computeReleaseGain(windowPeak(maxVal)), gain, aAtt, bAtt);
+#endif
+
+        for (int i = 0; i < NumChans; i++)
+        {
+            tmp32 = ((int64_t)gain * frame[i]) >> 31;
+            frame[i] = inSamps[i];
+            if (tmp32 > thresholdLin)
+                tmp32 = thresholdLin;
+            if (tmp32 < -thresholdLin)
+                tmp32 = -thresholdLin;
+            inSamps[i] = tmp32;
+        }
+
+        lookaheadCnt++;
+        if (lookaheadCnt >= nLookaheadSamps)
+            lookaheadCnt = 0;
+
+        return gain;
+    }
+
+private:
+    // the window holds the delayed frames plus the current one
+    enum { PeakCapacity = MaxLookahead + 1 };
+
+    int32_t lookaheadMem[MaxLookahead * NumChans];
+    int32_t peakVal[PeakCapacity];  // deque values, decreasing from head
+    uint32_t peakPos[PeakCapacity]; // deque frame numbers
+    int32_t peakHead;
+    int32_t peakSize;
+    uint32_t frameCnt;
+#if (LIMITER_ATTACK_AVERAGE)
+    int32_t attackMem[PeakCapacity];    // release gains of the window
+    int64_t attackSum;
+    int32_t attackScale;                // 1 / window length, Q31
+    int32_t attackCnt;
+#endif
+
+    // pushes the current frame peak and returns the window maximum
+    inline int32_t windowPeak(int32_t maxVal)
+    {
+        int32_t tail;
+
+        // drop the frame that left the window
+        if (peakSize > 0 && frameCnt - peakPos[peakHead] > (uint32_t)nLookaheadSamps)
+        {
+            peakHead = peakHead + 1 < PeakCapacity ? peakHead + 1 : 0;
+            peakSize--;
+        }
+
+        // drop all smaller values, they can never become the maximum
+        while (peakSize > 0)
+        {
+            tail = peakHead + peakSize - 1;
+            if (tail >= PeakCapacity)
+                tail -= PeakCapacity;
+            if (peakVal[tail] > maxVal)
+                break;
+            peakSize--;
+        }
+
+        tail = peakHead + peakSize;
+        if (tail >= PeakCapacity)
+            tail -= PeakCapacity;
+        peakVal[tail] = maxVal;
+        peakPos[tail] = frameCnt;
+        peakSize++;
+        frameCnt++;
+
+        return peakVal[peakHead];
+    }
+
+#if (LIMITER_ATTACK_AVERAGE)
+    // moving average of the release gain over the window
+    inline int32_t attackAverage(int32_t relGain)
+    {
+        attackSum += relGain - attackMem[attackCnt];
+        attackMem[attackCnt] = relGain;
+        attackCnt++;
+        if (attackCnt > nLookaheadSamps)
+            attackCnt = 0;
+
+        return (int32_t)((attackSum * attackScale) >> 31);
+    }
+#endif
+
+    void initLookahead(void)
+    {
+        if (nLookaheadSamps > MaxLookahead)
+            nLookaheadSamps = MaxLookahead;
+        if (nLookaheadSamps < 1)
+            nLookaheadSamps = 1;
+
+        for (int i = 0; i < MaxLookahead * NumChans; i++)
+            lookaheadMem[i] = 0;
+        lookaheadCnt = 0;
+
+        peakHead = 0;
+        peakSize = 0;
+        frameCnt = 0;
+
+#if (LIMITER_ATTACK_AVERAGE)
+        for (int i = 0; i < PeakCapacity; i++)
+            attackMem[i] = 0x7FFFFFFF;
+        attackSum = (int64_t)0x7FFFFFFF * (nLookaheadSamps + 1);
+        attackScale = 0x7FFFFFFF / (nLookaheadSamps + 1);
+        attackCnt = 0;
+#endif
+    }
+};
+
+// macro configured default instantiation
+typedef Limiter32N<MAX_LIMITER_CHANS> Limiter32;
 
 #endif // end of include guard
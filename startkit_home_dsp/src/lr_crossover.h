@@ -0,0 +1,204 @@
+/*---------------------------------------------------------------------------*\
+|   Linkwitz-Riley Crossover                                                  |
+|                                                                             |
+|   Splits NumChans channels into NumBands bands each, LR2, LR4 or LR8. The   |
+|   bands are split off as a tree: split k low-passes the remaining signal    |
+|   into band k and high-passes it on to split k+1, so every high-pass runs   |
+|   once. Band k additionally gets the allpass of each later crossover, so    |
+|   all bands are in phase and add up to an allpass. LR2 high-passes are      |
+|   inverted for the same reason. All sections run on the BiquadCascade       |
+|   kernel and are designed with EQ32, so EQ32_FIXED_DESIGN applies.          |
+|                                                                             |
+|   Output frames are band-major: out[frame][band * NumChans + channel].      |
+\*---------------------------------------------------------------------------*/
+
+#ifndef LR_CROSSOVER_H
+#define LR_CROSSOVER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "biquad_cascade.h"
+
+// crossover orders (slope 12, 24, 48 dB/octave)
+enum { LR2 = 2, LR4 = 4, LR8 = 8 };
+
+template <int NumChans, int NumBands>
+class LRCrossover
+{
+public:
+    enum {
+        NumSplits = NumBands - 1,
+        MaxFilterStages = 4,                            // one LR8 low/high-pass
+        MaxAllpassStages = 2,                           // one LR8 allpass
+        MaxLowStages = MaxFilterStages + (NumBands > 2 ? NumBands - 2 : 0) * MaxAllpassStages
+    };
+
+    // all bands pass the input unchanged until design() was called
+    LRCrossover(void)
+    {
+        order = 0;
+    }
+
+    // order LR2/LR4/LR8, freqs[NumSplits] ascending; returns false and keeps
+    // the old design on invalid settings
+    bool design(int order, const double freqs[], double fs)
+    {
+        int filterStages = order / 2;
+
+        if (order != LR2 && order != LR4 && order != LR8)
+            return false;
+
+        for (int k=0; k<NumSplits; k++)
+            if (freqs[k] <= 0 || freqs[k] >= fs / 2 || (k > 0 && freqs[k] <= freqs[k-1]))
+                return false;
+
+        for (int k=0; k<NumSplits; k++)
+        {
+            for (int s=0; s<filterStages; s++)
+            {
+                int32_t c[BIQUAD_COEFFS];
+
+                designFilter(LOW_PASS_EQ, order, s, freqs[k], fs, c);
+                low[k].setStageCoefficients(s, c);
+
+                designFilter(HIGH_PASS_EQ, order, s, freqs[k], fs, c);
+                high[k].setStageCoefficients(s, c);
+            }
+            high[k].setActiveStages(filterStages);
+
+            // phase compensation for the crossovers above band k + 1
+            int stages = filterStages;
+            for (int j=k+1; j<NumSplits; j++)
+                stages += designAllpass(order, freqs[j], fs, low[k], stages);
+            low[k].setActiveStages(stages);
+        }
+
+        this->order = order;
+        return true;
+    }
+
+    int getOrder(void) const
+    {
+        return order;
+    }
+
+    void resetStates(void)
+    {
+        for (int k=0; k<NumSplits; k++)
+        {
+            low[k].resetStates();
+            high[k].resetStates();
+        }
+    }
+
+    // in: interleaved frames of inStride channels, channels 0..NumChans-1
+    // are split; out: NumBands * NumChans channels per frame, may be in
+    inline void processBlock(const int32_t *in, int inStride, int32_t *out, size_t frames)
+    {
+        for (int k=0; k<NumSplits; k++)
+        {
+            low[k].beginBlock(frames);
+            high[k].beginBlock(frames);
+        }
+
+        for (size_t n=0; n<frames; n++, in+=inStride, out+=NumBands*NumChans)
+        {
+            int32_t x[NumChans];
+
+            for (int c=0; c<NumChans; c++)
+                x[c] = in[c];
+
+            for (int k=0; k<NumSplits; k++)
+                for (int c=0; c<NumChans; c++)
+                {
+                    out[k * NumChans + c] = low[k].run(x[c], c);
+                    x[c] = high[k].run(x[c], c);
+                }
+
+            for (int c=0; c<NumChans; c++)
+                out[NumSplits * NumChans + c] = x[c];
+        }
+    }
+
+private:
+    // a cascade that is fed sample by sample from the split loop
+    template <int NumStages>
+    class Section : public BiquadCascade<NumStages, NumChans>
+    {
+    public:
+        // pending coefficients are only taken at the block boundary
+        inline void beginBlock(size_t frames)
+        {
+            this->updateCoefficients(frames);
+        }
+
+        inline int32_t run(int32_t x, int chan)
+        {
+            return this->processSample(x, chan);
+        }
+    };
+
+    Section<MaxLowStages> low[NumSplits > 0 ? NumSplits : 1];
+    Section<MaxFilterStages> high[NumSplits > 0 ? NumSplits : 1];
+    int order;
+
+    // Butterworth pole pairs: LR4 = BW2^2 (Q 0.7071), LR8 = BW4^2 (Q 0.5412
+    // and 1.3066), LR2 = BW1^2 is one biquad with Q 0.5. EQ32 designs with
+    // alpha = sin(w0) * sinh(1/(2Q)), these values give the same poles.
+    static double stageQ(int order, int stage)
+    {
+        if (order == LR2)
+            return 0.56729633;
+        if (order == LR4)
+            return 0.75932572;
+        return (stage & 1) ? 1.33722126 : 0.60495233;
+    }
+
+    static void designFilter(int type, int order, int stage, double f0, double fs,
+                             int32_t c[BIQUAD_COEFFS])
+    {
+        EQ32Base eq(type, f0, fs, 0., stageQ(order, stage));
+
+        eq.getNewCoefficients(c);
+
+        // LR2 bands are 180 degrees apart, invert the high-pass
+        if (type == HIGH_PASS_EQ && order == LR2)
+            for (int i=0; i<3; i++)
+                c[i] = -c[i];
+    }
+
+    // adds the allpass of one crossover at stage first, returns its stages
+    static int designAllpass(int order, double f0, double fs,
+                             Section<MaxLowStages> &section, int first)
+    {
+        int32_t c[BIQUAD_COEFFS];
+
+        if (order == LR2)
+        {
+            // first-order allpass (z^-1 - p) / (1 - p z^-1) with the pole
+            // p of the LR2 low-pass, whose -a1 is 2p
+            designFilter(LOW_PASS_EQ, order, 0, f0, fs, c);
+            int32_t p = (c[3] + 1) >> 1;
+
+            c[0] = -p;
+            c[1] = fixed_one;
+            c[2] = 0;
+            c[3] = p;
+            c[4] = 0;
+            section.setStageCoefficients(first, c);
+            return 1;
+        }
+
+        int stages = order == LR8 ? 2 : 1;
+        for (int s=0; s<stages; s++)
+        {
+            EQ32Base eq(ALLPASS_EQ, f0, fs, 0., stageQ(order, s));
+
+            eq.getNewCoefficients(c);
+            section.setStageCoefficients(first + s, c);
+        }
+        return stages;
+    }
+};
+
+#endif  // LR_CROSSOVER_H
@@ -0,0 +1,164 @@
+/*---------------------------------------------------------------------------*\
+|   Multiband Dynamics                                                        |
+|                                                                             |
+|   Splits NumChans channels into NumBands bands, compresses every band with  |
+|   its own Dynamics32 gain computer and sums the bands, all in one pass      |
+|   over the block. The split is complementary: split k low-passes the       |
+|   remainder into band k and passes remainder - band k on, the last band is  |
+|   the final remainder. The bands therefore add up to the input exactly      |
+|   (the upper bands are not Linkwitz-Riley shaped, the sum is what counts    |
+|   here). The low-passes are designed with EQ32 and run on the shared        |
+|   biquadSample() kernel.                                                    |
+|                                                                             |
+|   Per band and sample: one biquad, one subtraction, the peak search and     |
+|   one multiply-add. Each band takes its gain from the peak of the previous  |
+|   block, so detection lags by one block. A band whose gain is 0 dB passes   |
+|   unchanged, with all bands idle the output equals the input.               |
+\*---------------------------------------------------------------------------*/
+
+#ifndef MULTIBAND_DYNAMICS_H
+#define MULTIBAND_DYNAMICS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "eq32.h"
+#include "dynamics32.h"
+
+template <int NumChans, int NumBands, bool ErrorFeedback = (ERROR_FEEDBACK != 0)>
+class MultibandDynamics
+{
+public:
+    enum { NumSplits = NumBands - 1 };
+
+    // all bands pass the input unchanged until design() was called
+    MultibandDynamics(void)
+    {
+        for (int k=0; k<NumSplits; k++)
+        {
+            coeffs[k][0] = fixed_one;
+            for (int i=1; i<BIQUAD_COEFFS; i++)
+                coeffs[k][i] = 0;
+        }
+        resetStates();
+    }
+
+    // freqs[NumSplits] ascending; returns false and keeps the old design
+    // on invalid settings
+    bool design(const double freqs[], double fs)
+    {
+        for (int k=0; k<NumSplits; k++)
+            if (freqs[k] <= 0 || freqs[k] >= fs / 2 || (k > 0 && freqs[k] <= freqs[k-1]))
+                return false;
+
+        for (int k=0; k<NumSplits; k++)
+        {
+            EQ32Base eq(LOW_PASS_EQ, freqs[k], fs, 0., 0.7071);
+            eq.getNewCoefficients(coeffs[k]);
+        }
+        return true;
+    }
+
+    // compressor/expander settings of band k, lowest band first
+    Dynamics32Base &band(int k)
+    {
+        return bands[k];
+    }
+
+    void resetStates(void)
+    {
+        for (int k=0; k<NumSplits; k++)
+            for (int c=0; c<NumChans; c++)
+                for (int j=0; j<BIQUAD_STATES; j++)
+                    states[k][c][j] = 0;
+
+        for (int k=0; k<NumBands; k++)
+        {
+            bands[k].resetStates();
+            peaks[k] = 0;
+            gains[k] = unity();
+        }
+    }
+
+    // interleaved block: samples[frame * NumChans + channel]
+    inline void processBlock(int32_t *interleaved, size_t frames)
+    {
+        int64_t g[NumBands];
+        int64_t step[NumBands];
+        uint32_t peak[NumBands];
+
+        if (frames == 0)
+            return;
+
+        // gains of this block from the peaks of the last one
+        for (int k=0; k<NumBands; k++)
+        {
+            int64_t target = bands[k].nextGain(peaks[k], frames);
+
+            step[k] = (target - gains[k]) / (int64_t)frames;
+            g[k] = target - step[k] * (int64_t)(frames - 1);
+            gains[k] = target;
+            peak[k] = 0;
+        }
+
+        for (size_t n=0; n<frames; n++, interleaved+=NumChans)
+        {
+            for (int c=0; c<NumChans; c++)
+            {
+                int32_t x = interleaved[c];
+                int64_t acc = 0;
+
+                for (int k=0; k<NumSplits; k++)
+                {
+                    int32_t b = biquadSample<ErrorFeedback>(coeffs[k], states[k][c], x,
+                                                            BIQUAD_FULL);
+                    uint32_t mag = b < 0 ? 0u - (uint32_t)b : (uint32_t)b;
+
+                    if (mag > peak[k])
+                        peak[k] = mag;
+                    acc += g[k] * b;
+                    x -= b;
+                }
+
+                uint32_t mag = x < 0 ? 0u - (uint32_t)x : (uint32_t)x;
+                if (mag > peak[NumSplits])
+                    peak[NumSplits] = mag;
+                acc += g[NumSplits] * x;
+
+                acc >>= 31;
+                interleaved[c] = acc > 0x7FFFFFFF ? 0x7FFFFFFF :
+                                 acc < -(int64_t)0x80000000 ? (int32_t)0x80000000 : (int32_t)acc;
+            }
+
+            for (int k=0; k<NumBands; k++)
+                g[k] += step[k];
+        }
+
+        for (int k=0; k<NumBands; k++)
+            peaks[k] = peak[k];
+    }
+
+private:
+    // 0 dB is 2^31 here, so that idle bands sum up exactly
+    static int64_t unity(void)
+    {
+        return (int64_t)1 << 31;
+    }
+
+    class Band : public Dynamics32Base
+    {
+    public:
+        inline int64_t nextGain(uint32_t peak, size_t frames)
+        {
+            gain = updateGain(peak, frames);
+            return gain == 0x7FFFFFFF ? unity() : gain;
+        }
+    };
+
+    int32_t coeffs[NumSplits > 0 ? NumSplits : 1][BIQUAD_COEFFS];
+    int32_t states[NumSplits > 0 ? NumSplits : 1][NumChans][BIQUAD_STATES];
+    Band bands[NumBands];
+    uint32_t peaks[NumBands];                   // of the last block
+    int64_t gains[NumBands];                    // of the last frame, Q31
+};
+
+#endif  // MULTIBAND_DYNAMICS_H
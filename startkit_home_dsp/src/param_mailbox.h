@@ -0,0 +1,77 @@
+/*---------------------------------------------------------------------------*\
+|   Single-Producer / Single-Consumer Parameter Mailbox                       |
+|                                                                             |
+|   A control task fills the free slot and publishes it by incrementing a     |
+|   sequence number. The DSP task fetches the newest slot at a block          |
+|   boundary with a wait-free check: if the producer touched the slot while   |
+|   it was being copied, the copy is dropped and picked up one block later.   |
+|   The DSP never reads half-updated parameters and never blocks.             |
+\*---------------------------------------------------------------------------*/
+
+#ifndef PARAM_MAILBOX_H
+#define PARAM_MAILBOX_H
+
+#include <stdint.h>
+
+#if defined(__xcore__) || defined(__XS1B__) || defined(__XS2A__)
+// one tile shares one in-order memory, only stop compiler reordering
+#define MAILBOX_BARRIER() __asm__ __volatile__("" ::: "memory")
+#else
+#define MAILBOX_BARRIER() __sync_synchronize()
+#endif
+
+template <typename T>
+class ParamMailbox
+{
+public:
+    ParamMailbox(void)
+    {
+        seq = 0;
+        consumed = 0;
+    }
+
+    // producer: slot to fill, not visible to the consumer until publish()
+    T &beginWrite(void)
+    {
+        return slots[(seq + 1) & 1];
+    }
+
+    // producer: make the slot returned by beginWrite() the newest one
+    void publish(void)
+    {
+        MAILBOX_BARRIER();
+        seq = seq + 1;
+        // the next beginWrite() overwrites the slot a consumer may still
+        // copy; the new seq must be visible before that, or fetch() misses
+        // the race
+        MAILBOX_BARRIER();
+    }
+
+    // consumer: copies the newest parameters into out, returns false if
+    // there is nothing new or the producer raced with the copy
+    bool fetch(T &out)
+    {
+        uint32_t s = seq;
+
+        if (s == consumed)
+            return false;
+
+        MAILBOX_BARRIER();
+        out = slots[s & 1];
+        MAILBOX_BARRIER();
+
+        // the producer only writes slot s & 1 after publishing s + 1
+        if (seq != s)
+            return false;
+
+        consumed = s;
+        return true;
+    }
+
+private:
+    T slots[2];
+    volatile uint32_t seq;      // number of published updates
+    uint32_t consumed;          // last sequence number taken by the consumer
+};
+
+#endif  // PARAM_MAILBOX_H
@@ -3,18 +3,56 @@
 #define _AUDIO_EFFECTS_H_
 #include <startkit_gpio.h>
 #include <stddef.h>
+#include <stdint.h>
+#include "global_defines.h"
+#include "dsp_load.h"
 
-/** Task to apply audio effects to a sample stream.
+/** One block of interleaved audio, owned by either i2s_handler or
+ *  audio_effects. in[] is filled by I2S, out[] is played by I2S.
+ */
+typedef struct audio_block_t {
+  int32_t in[DSP_BLOCK_FRAMES * NUM_CHANS];
+  int32_t out[DSP_BLOCK_FRAMES * NUM_CHANS];
+} audio_block_t;
+
+/** Interface to query the processing load of audio_effects.
  *
- *  \param c_dsp_eq   channel for receiving samples and sending updated samples
- *  \param i_led      LED interface connection to startkit_gpio task
- *  \param i_button   button control connection to the startkit_gpio task
- *  \param c_gain     channel for receiving updates to the gain parameter
- *                    of the effects
+ *  Times are in reference timer ticks (10 ns), the deadline of a pass
+ *  is one block period.
  */
-void audio_effects(streaming chanend c_dsp, static const size_t num_chans);
+typedef interface dsp_load_if {
+  /** Get a copy of the load statistics since the last reset. */
+  void get_stats(dsp_load_stats_t &stats);
+
+  /** Restart the statistics. */
+  void reset_stats();
 
+  /** Get the startup times in reference timer ticks since reset: the end
+   *  of cppdsp_init_eq() and the end of the first processed block
+   *  (0 until it was processed).
+   */
+  void get_startup(unsigned &init_done, unsigned &first_block);
+} dsp_load_if;
+
+/** Task to apply audio effects to a block stream.
+ *
+ *  On startup the task sends the address of its two audio blocks over
+ *  c_dsp. After that the I2S side sends the index of each block it has
+ *  filled and receives the index of the block to fill next.
+ *
+ *  \param c_dsp      channel for exchanging audio block ownership
+ *  \param i_load     interface serving the processing load statistics
+ */
+void audio_effects(streaming chanend c_dsp, server dsp_load_if i_load);
+
+/** Front panel task: shows the peak DSP load on the LEDs and prints the
+ *  load statistics; the sliders set the gain of the bass (x) and treble
+ *  (y) EQ bands. It is the control task of cppdsp, the only caller of
+ *  cppdsp_set_eq_band_gain_steps(), and starts changing the chain after
+ *  audio_effects has run cppdsp_init_eq().
+ */
 void ui_handler(client startkit_led_if i_led, client startkit_button_if i_button,
-        client slider_if i_slider_x, client slider_if i_slider_y);
+        client slider_if i_slider_x, client slider_if i_slider_y,
+        client dsp_load_if i_load);
 
 #endif // _AUDIO_EFFECTS_H_
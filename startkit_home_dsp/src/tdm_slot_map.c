@@ -0,0 +1,36 @@
+/*
+ * tdm_slot_map.c
+ *
+ *  Channel routing of the TDM output mode.
+ */
+
+#include "tdm_slot_map.h"
+
+#if TDM_OUTPUT
+
+// processing channel 2*band + side, band 0 = lowest: L/R of each band
+// get the same input and their own crossover/EQ stages
+const uint8_t tdm_input_map[NUM_CHANS] = {
+  0, 1, 0, 1, 0, 1, 0, 1
+};
+
+// 8 channel DAC on slots 0..7, the rest of the 16 slot frame is silent
+const int8_t tdm_slot_map[TDM_CHANS_PER_FRAME] = {
+  0, 1, 2, 3, 4, 5, 6, 7,
+  TDM_SLOT_UNUSED, TDM_SLOT_UNUSED, TDM_SLOT_UNUSED, TDM_SLOT_UNUSED,
+  TDM_SLOT_UNUSED, TDM_SLOT_UNUSED, TDM_SLOT_UNUSED, TDM_SLOT_UNUSED
+};
+
+void tdm_fan_in(const int32_t codec_in[CODEC_CHANS], int32_t frame[NUM_CHANS])
+{
+  for (int c = 0; c < NUM_CHANS; c++)
+    frame[c] = codec_in[tdm_input_map[c]];
+}
+
+void tdm_fill_slots(const int32_t frame[NUM_CHANS], int32_t slots[TDM_CHANS_PER_FRAME])
+{
+  for (int s = 0; s < TDM_CHANS_PER_FRAME; s++)
+    slots[s] = tdm_slot_map[s] == TDM_SLOT_UNUSED ? 0 : frame[tdm_slot_map[s]];
+}
+
+#endif // TDM_OUTPUT
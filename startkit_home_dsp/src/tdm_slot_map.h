@@ -0,0 +1,46 @@
+/*
+ * tdm_slot_map.h
+ *
+ *  Channel routing of the TDM output mode (TDM_OUTPUT=1). The stereo
+ *  codec input is fanned out to the NUM_CHANS processing channels, the
+ *  processed channels are assigned to the slots of the TDM frame. Edit
+ *  the tables in tdm_slot_map.c for a different speaker layout.
+ *
+ *  i2s_handler applies the tables per frame, the host tool tdmsim runs
+ *  the same functions on a WAV file.
+ */
+
+#ifndef TDM_SLOT_MAP_H_
+#define TDM_SLOT_MAP_H_
+
+#include <stdint.h>
+#include "global_defines.h"
+
+#if TDM_OUTPUT
+
+// slot without a processing channel, sends silence
+#define TDM_SLOT_UNUSED (-1)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// codec input channel feeding each processing channel
+extern const uint8_t tdm_input_map[NUM_CHANS];
+
+// processing channel played in each TDM slot, or TDM_SLOT_UNUSED
+extern const int8_t tdm_slot_map[TDM_CHANS_PER_FRAME];
+
+// one frame: codec input -> processing channels
+void tdm_fan_in(const int32_t codec_in[CODEC_CHANS], int32_t frame[NUM_CHANS]);
+
+// one frame: processing channels -> TDM slots
+void tdm_fill_slots(const int32_t frame[NUM_CHANS], int32_t slots[TDM_CHANS_PER_FRAME]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TDM_OUTPUT
+
+#endif /* TDM_SLOT_MAP_H_ */